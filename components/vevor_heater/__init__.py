@@ -1,6 +1,12 @@
+import zlib
+
 import esphome.codegen as cg
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome.components import sensor, uart, text_sensor, binary_sensor, number, switch, button, time, select
+from esphome.components import web_server_base
+from esphome.components.esp32 import get_esp32_variant
+from esphome.components.esp32.const import VARIANT_ESP32, VARIANT_ESP32S3
 from esphome.const import (
     CONF_ID,
     CONF_UART_ID,
@@ -13,10 +19,16 @@ from esphome.const import (
     UNIT_REVOLUTIONS_PER_MINUTE,
     UNIT_SECOND,
     UNIT_PERCENT,
+    UNIT_HOUR,
+    UNIT_MINUTE,
+    UNIT_MILLISECOND,
+    UNIT_WATT,
+    UNIT_KILOWATT_HOURS,
     DEVICE_CLASS_TEMPERATURE,
     DEVICE_CLASS_VOLTAGE,
     DEVICE_CLASS_CURRENT,
     DEVICE_CLASS_POWER,
+    DEVICE_CLASS_ENERGY,
     STATE_CLASS_MEASUREMENT,
     STATE_CLASS_TOTAL_INCREASING,
     ICON_THERMOMETER,
@@ -24,20 +36,40 @@ from esphome.const import (
     ICON_FAN,
     ICON_POWER,
 )
+from esphome.core import CORE, ID
 
 AUTO_LOAD = ["sensor", "text_sensor", "binary_sensor", "number", "button", "select", "switch"]
 DEPENDENCIES = ["uart"]
+MULTI_CONF = True
 
 vevor_heater_ns = cg.esphome_ns.namespace("vevor_heater")
 VevorHeater = vevor_heater_ns.class_("VevorHeater", cg.PollingComponent)
+VevorBus = vevor_heater_ns.class_("VevorBus", cg.Component, uart.UARTDevice)
 VevorInjectedPerPulseNumber = vevor_heater_ns.class_("VevorInjectedPerPulseNumber", number.Number, cg.Component)
 VevorResetTotalConsumptionButton = vevor_heater_ns.class_("VevorResetTotalConsumptionButton", button.Button, cg.Component)
+VevorRefillVolumeNumber = vevor_heater_ns.class_("VevorRefillVolumeNumber", number.Number, cg.Component)
+VevorLogRefillButton = vevor_heater_ns.class_("VevorLogRefillButton", button.Button, cg.Component)
+VevorRefillTankButton = vevor_heater_ns.class_("VevorRefillTankButton", button.Button, cg.Component)
+VevorScheduleSwitch = vevor_heater_ns.class_("VevorScheduleSwitch", switch.Switch, cg.Component)
+VevorClearFaultLogButton = vevor_heater_ns.class_("VevorClearFaultLogButton", button.Button, cg.Component)
+VevorServiceResetButton = vevor_heater_ns.class_("VevorServiceResetButton", button.Button, cg.Component)
+VevorResetLockoutButton = vevor_heater_ns.class_("VevorResetLockoutButton", button.Button, cg.Component)
+VevorFrameCaptureSwitch = vevor_heater_ns.class_("VevorFrameCaptureSwitch", switch.Switch, cg.Component)
+VevorDumpFrameCaptureButton = vevor_heater_ns.class_("VevorDumpFrameCaptureButton", button.Button, cg.Component)
 VevorControlModeSelect = vevor_heater_ns.class_("VevorControlModeSelect", select.Select, cg.Component)
 VevorHeaterPowerSwitch = vevor_heater_ns.class_("VevorHeaterPowerSwitch", switch.Switch, cg.Component)
 VevorHeaterPowerLevelNumber = vevor_heater_ns.class_("VevorHeaterPowerLevelNumber", number.Number, cg.Component)
 
+# Built-in heater models, one per profile block in heater_profile.h. Only the selected
+# profile is compiled in; its frame device IDs are mirrored here for validation, heaters
+# answer with the heater ID unless configured otherwise.
+HEATER_MODELS = {
+    "vevor": {"define": "VEVOR_HEATER_MODEL_VEVOR", "controller_id": 0x66, "heater_id": 0x77},
+}
+
 # Configuration keys
 CONF_AUTO_SENSORS = "auto_sensors"
+CONF_MODEL = "model"
 CONF_CURRENT_TEMPERATURE = "current_temperature"
 CONF_CONTROL_MODE = "control_mode"
 CONF_CONTROL_MODE_SELECT = "control_mode_select"
@@ -46,9 +78,71 @@ CONF_EXTERNAL_TEMPERATURE_SENSOR = "external_temperature_sensor"
 CONF_INJECTED_PER_PULSE = "injected_per_pulse"
 CONF_INJECTED_PER_PULSE_NUMBER = "injected_per_pulse_number"
 CONF_POLLING_INTERVAL = "polling_interval"
+CONF_FUEL_SAVE_INTERVAL = "fuel_save_interval"
+CONF_HEATING_VALUE = "heating_value"
+CONF_EFFICIENCY = "efficiency"
 CONF_RESET_TOTAL_CONSUMPTION_BUTTON = "reset_total_consumption_button"
+CONF_REFILL_VOLUME_NUMBER = "refill_volume_number"
+CONF_LOG_REFILL_BUTTON = "log_refill_button"
+CONF_TANK_CAPACITY = "tank_capacity"
+CONF_LOW_FUEL_THRESHOLD = "low_fuel_threshold"
+CONF_LOW_FUEL_SHUTDOWN = "low_fuel_shutdown"
+CONF_REFILL_TANK_BUTTON = "refill_tank_button"
+CONF_SCHEDULE = "schedule"
+CONF_SCHEDULE_SWITCH = "schedule_switch"
+CONF_DAYS = "days"
+CONF_START = "start"
+CONF_END = "end"
+CONF_POWER = "power"
+CONF_TARGET_TEMPERATURE = "target_temperature"
+CONF_PREHEAT = "preheat"
+CONF_OVERHEAT_TEMPERATURE = "overheat_temperature"
+CONF_CLEAR_FAULT_LOG_BUTTON = "clear_fault_log_button"
+CONF_MAX_START_FAILURES = "max_start_failures"
+CONF_RESTART_BACKOFF = "restart_backoff"
+CONF_MAX_RESTART_BACKOFF = "max_restart_backoff"
+CONF_RESET_LOCKOUT_BUTTON = "reset_lockout_button"
+CONF_RESTART_TEMPERATURE = "restart_temperature"
+CONF_RESUME_AFTER_REBOOT = "resume_after_reboot"
+CONF_FRAME_CAPTURE_CAPACITY = "frame_capture_capacity"
+CONF_DEVICE_ID = "device_id"
+CONF_BUS_SLOT_TIMEOUT = "bus_slot_timeout"
+CONF_ADDRESSED_REQUESTS = "addressed_requests"
+CONF_REJECT_BAD_CHECKSUM = "reject_bad_checksum"
+CONF_STATUS_ENDPOINT = "status_endpoint"
+CONF_STATUS_PATH = "path"
+CONF_WEB_SERVER_BASE_ID = "web_server_base_id"
+CONF_UART_TASK = "uart_task"
+CONF_CORE = "core"
+CONF_PRIORITY = "priority"
+CONF_TEMPERATURE_INPUTS = "temperature_inputs"
+CONF_TEMPERATURE_MODE = "temperature_mode"
+CONF_SENSOR = "sensor"
+CONF_WEIGHT = "weight"
+CONF_CRITICAL = "critical"
+CONF_MAX_AGE = "max_age"
+CONF_TELEMETRY = "telemetry"
+CONF_TELEMETRY_TOPIC = "topic"
+CONF_TELEMETRY_INTERVAL = "interval"
+CONF_ON_STATE_CHANGE = "on_state_change"
+CONF_FRAME_CAPTURE_SWITCH = "frame_capture_switch"
+CONF_DUMP_FRAME_CAPTURE_BUTTON = "dump_frame_capture_button"
 CONF_POWER_SWITCH = "power_switch"
 CONF_POWER_LEVEL_NUMBER = "power_level_number"
+CONF_ALTITUDE = "altitude"
+CONF_ALTITUDE_SENSOR = "altitude_sensor"
+CONF_PRESSURE_SENSOR = "pressure_sensor"
+CONF_ALTITUDE_POWER_LIMIT = "altitude_power_limit"
+CONF_MAX_POWER = "max_power"
+CONF_FUEL_TEMPERATURE_SENSOR = "fuel_temperature_sensor"
+CONF_FUEL_TEMPERATURE_CORRECTION = "fuel_temperature_correction"
+CONF_TEMPERATURE = "temperature"
+CONF_FACTOR = "factor"
+CONF_SERVICE_INTERVAL = "service_interval"
+CONF_BURNER_HOURS_INTERVAL = "burner_hours"
+CONF_IGNITIONS_INTERVAL = "ignitions"
+CONF_SERVICE_RESET_BUTTON = "service_reset_button"
+CONF_LATENCY = "latency"
 
 # Control mode options
 CONTROL_MODE_MANUAL = "manual"
@@ -69,10 +163,39 @@ CONF_HOURLY_CONSUMPTION = "hourly_consumption"
 CONF_DAILY_CONSUMPTION = "daily_consumption"
 CONF_TOTAL_CONSUMPTION = "total_consumption"
 CONF_LOW_VOLTAGE_ERROR = "low_voltage_error"
+CONF_FUEL_SINCE_REFILL = "fuel_since_refill"
+CONF_TANK_REMAINING = "tank_remaining"
+CONF_TANK_LEVEL = "tank_level"
+CONF_TANK_HOURS_LEFT = "tank_hours_left"
+CONF_LOW_FUEL = "low_fuel"
+CONF_SCHEDULE_NEXT_EVENT = "schedule_next_event"
+CONF_PREHEAT_LEAD_TIME = "preheat_lead_time"
+CONF_FAULT_COUNT = "fault_count"
+CONF_LAST_FAULT = "last_fault"
+CONF_CONTROLLER_STATE = "controller_state"
+CONF_FAILED_STARTS = "failed_starts"
+CONF_RESTART_BACKOFF_REMAINING = "restart_backoff_remaining"
+CONF_RESTART_LOCKOUT = "restart_lockout"
+CONF_COOLDOWN_TIME = "cooldown_time"
+CONF_THERMAL_POWER = "thermal_power"
+CONF_DAILY_ENERGY = "daily_energy"
+CONF_TOTAL_ENERGY = "total_energy"
+CONF_EFFECTIVE_MAX_POWER = "effective_max_power"
+CONF_EFFECTIVE_INJECTED_PER_PULSE = "effective_injected_per_pulse"
+CONF_BURNER_HOURS = "burner_hours"
+CONF_FAN_HOURS = "fan_hours"
+CONF_IGNITION_COUNT = "ignition_count"
+CONF_BURNER_HOURS_SINCE_SERVICE = "burner_hours_since_service"
+CONF_IGNITIONS_SINCE_SERVICE = "ignitions_since_service"
+CONF_SERVICE_DUE = "service_due"
+
+# Tank entities only make sense when a tank capacity is configured
+TANK_ENTITY_KEYS = [CONF_TANK_REMAINING, CONF_TANK_LEVEL, CONF_TANK_HOURS_LEFT, CONF_LOW_FUEL, CONF_REFILL_TANK_BUTTON]
 
 # Fuel consumption constants
 UNIT_MILLILITERS = "ml"
 UNIT_MILLILITERS_PER_HOUR = "ml/h"
+UNIT_LITERS = "L"
 
 # Simplified sensor schemas with good defaults - removed duplicate temperature sensor
 SENSOR_SCHEMAS = {
@@ -144,13 +267,380 @@ SENSOR_SCHEMAS = {
         state_class=STATE_CLASS_TOTAL_INCREASING,
         accuracy_decimals=2,
         icon="mdi:fuel",
+    ),
+    CONF_FUEL_SINCE_REFILL: sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLILITERS,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=0,
+        icon="mdi:gas-station",
+    ),
+    CONF_THERMAL_POWER: sensor.sensor_schema(
+        unit_of_measurement=UNIT_WATT,
+        device_class=DEVICE_CLASS_POWER,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=0,
+        icon="mdi:radiator",
+    ),
+    CONF_DAILY_ENERGY: sensor.sensor_schema(
+        unit_of_measurement=UNIT_KILOWATT_HOURS,
+        device_class=DEVICE_CLASS_ENERGY,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=3,
+    ),
+    CONF_TOTAL_ENERGY: sensor.sensor_schema(
+        unit_of_measurement=UNIT_KILOWATT_HOURS,
+        device_class=DEVICE_CLASS_ENERGY,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=2,
+    ),
+    CONF_EFFECTIVE_MAX_POWER: sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=0,
+        icon="mdi:image-filter-hdr",
+        entity_category="diagnostic",
+    ),
+    CONF_EFFECTIVE_INJECTED_PER_PULSE: sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLILITERS,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=4,
+        icon="mdi:water-pump",
+        entity_category="diagnostic",
+    ),
+    CONF_TANK_REMAINING: sensor.sensor_schema(
+        unit_of_measurement=UNIT_LITERS,
+        device_class="volume_storage",
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=2,
+        icon="mdi:storage-tank",
+    ),
+    CONF_TANK_LEVEL: sensor.sensor_schema(
+        unit_of_measurement=UNIT_PERCENT,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=0,
+        icon="mdi:storage-tank-outline",
+    ),
+    CONF_TANK_HOURS_LEFT: sensor.sensor_schema(
+        unit_of_measurement=UNIT_HOUR,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=1,
+        icon="mdi:timer-sand",
+    ),
+    CONF_LOW_FUEL: binary_sensor.binary_sensor_schema(
+        icon="mdi:gas-station-off",
+        device_class="problem",
+    ),
+    CONF_SCHEDULE_NEXT_EVENT: text_sensor.text_sensor_schema(
+        icon="mdi:calendar-clock",
+    ),
+    CONF_PREHEAT_LEAD_TIME: sensor.sensor_schema(
+        unit_of_measurement=UNIT_MINUTE,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=0,
+        icon="mdi:timer-play-outline",
+    ),
+    CONF_FAULT_COUNT: sensor.sensor_schema(
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=0,
+        icon="mdi:alert-octagon",
+        entity_category="diagnostic",
+    ),
+    CONF_LAST_FAULT: text_sensor.text_sensor_schema(
+        icon="mdi:alert-octagon-outline",
+        entity_category="diagnostic",
+    ),
+    CONF_CONTROLLER_STATE: text_sensor.text_sensor_schema(
+        icon="mdi:state-machine",
+        entity_category="diagnostic",
+    ),
+    CONF_FAILED_STARTS: sensor.sensor_schema(
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=0,
+        icon="mdi:restart-alert",
+        entity_category="diagnostic",
+    ),
+    CONF_RESTART_BACKOFF_REMAINING: sensor.sensor_schema(
+        unit_of_measurement=UNIT_SECOND,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=0,
+        icon="mdi:timer-sand",
+        entity_category="diagnostic",
+    ),
+    CONF_RESTART_LOCKOUT: binary_sensor.binary_sensor_schema(
+        icon="mdi:lock-alert",
+        device_class="problem",
+    ),
+    CONF_COOLDOWN_TIME: sensor.sensor_schema(
+        unit_of_measurement=UNIT_SECOND,
+        state_class=STATE_CLASS_MEASUREMENT,
+        accuracy_decimals=0,
+        icon="mdi:fan-clock",
+    ),
+    CONF_BURNER_HOURS: sensor.sensor_schema(
+        unit_of_measurement=UNIT_HOUR,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=1,
+        icon="mdi:fire-circle",
+        entity_category="diagnostic",
+    ),
+    CONF_FAN_HOURS: sensor.sensor_schema(
+        unit_of_measurement=UNIT_HOUR,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=1,
+        icon="mdi:fan-clock",
+        entity_category="diagnostic",
+    ),
+    CONF_IGNITION_COUNT: sensor.sensor_schema(
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=0,
+        icon="mdi:lightning-bolt-circle",
+        entity_category="diagnostic",
+    ),
+    CONF_BURNER_HOURS_SINCE_SERVICE: sensor.sensor_schema(
+        unit_of_measurement=UNIT_HOUR,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=1,
+        icon="mdi:wrench-clock",
+        entity_category="diagnostic",
+    ),
+    CONF_IGNITIONS_SINCE_SERVICE: sensor.sensor_schema(
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        accuracy_decimals=0,
+        icon="mdi:counter",
+        entity_category="diagnostic",
+    ),
+    CONF_SERVICE_DUE: binary_sensor.binary_sensor_schema(
+        icon="mdi:wrench-clock",
+        device_class="problem",
     ),}
 
+# Schedule day bits match ESPTime day_of_week - 1 (bit 0 = Sunday)
+SCHEDULE_DAYS = {"SUN": 0, "MON": 1, "TUE": 2, "WED": 3, "THU": 4, "FRI": 5, "SAT": 6}
+# Matches SCHEDULE_PREHEAT_AUTO - lead time comes from the warm-up predictor
+PREHEAT_AUTO = 255
+
+
+def schedule_time(value):
+    value = cv.string_strict(value)
+    try:
+        hour, minute = (int(part) for part in value.split(":"))
+    except ValueError as err:
+        raise cv.Invalid(f"Time must be in HH:MM format, got '{value}'") from err
+    if not (0 <= hour < 24 and 0 <= minute < 60):
+        raise cv.Invalid(f"Invalid time of day '{value}'")
+    return hour * 60 + minute
+
+
+SCHEDULE_SLOT_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Required(CONF_DAYS): cv.ensure_list(cv.one_of(*SCHEDULE_DAYS, upper=True)),
+            cv.Required(CONF_START): schedule_time,
+            cv.Required(CONF_END): schedule_time,
+            cv.Optional(CONF_POWER): cv.float_range(min=10.0, max=100.0),
+            cv.Optional(CONF_TARGET_TEMPERATURE): cv.float_range(min=0.0, max=40.0),
+            cv.Optional(CONF_PREHEAT, default="0min"): cv.Any(
+                cv.one_of("auto", lower=True),
+                cv.All(
+                    cv.positive_time_period_minutes,
+                    cv.Range(max=cv.TimePeriod(minutes=180)),
+                ),
+            ),
+        }
+    ),
+    cv.has_at_least_one_key(CONF_POWER, CONF_TARGET_TEMPERATURE),
+)
+
+
+def validate_tank(config):
+    if CONF_TANK_CAPACITY not in config:
+        for key in TANK_ENTITY_KEYS:
+            if key in config:
+                raise cv.Invalid(f"'{key}' requires '{CONF_TANK_CAPACITY}' to be set")
+    return config
+
+
+def validate_schedule(config):
+    if (CONF_SCHEDULE in config or CONF_SCHEDULE_SWITCH in config) and CONF_TIME_ID not in config:
+        raise cv.Invalid(f"'{CONF_SCHEDULE}' requires '{CONF_TIME_ID}' for local time")
+    return config
+
+TEMPERATURE_MODES = {
+    "min": "MIN",
+    "max": "MAX",
+    "mean": "WEIGHTED_MEAN",
+    "lowest_critical": "LOWEST_CRITICAL",
+}
+
+# Latency histograms (LatencyMetric, LatencyStat in latency_tracker.h), each one optional
+LATENCY_METRICS = {
+    "round_trip": "ROUND_TRIP",
+    "intent_to_wire": "INTENT_TO_WIRE",
+    "intent_to_confirmed": "INTENT_TO_CONFIRMED",
+}
+LATENCY_STATS = {"p50": "P50", "p95": "P95", "max": "MAX"}
+
+LATENCY_SENSOR_SCHEMA = sensor.sensor_schema(
+    unit_of_measurement=UNIT_MILLISECOND,
+    state_class=STATE_CLASS_MEASUREMENT,
+    accuracy_decimals=0,
+    icon="mdi:timer-outline",
+    entity_category="diagnostic",
+)
+
+LATENCY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(metric): cv.Schema({cv.Optional(stat): LATENCY_SENSOR_SCHEMA for stat in LATENCY_STATS})
+        for metric in LATENCY_METRICS
+    }
+)
+
+TEMPERATURE_INPUT_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_SENSOR): cv.use_id(sensor.Sensor),
+        cv.Optional(CONF_WEIGHT, default=1.0): cv.float_range(min=0.01, max=100.0),
+        cv.Optional(CONF_CRITICAL, default=False): cv.boolean,
+        cv.Optional(CONF_MAX_AGE, default="5min"): cv.All(
+            cv.positive_time_period_milliseconds,
+            cv.Range(min=cv.TimePeriod(seconds=10)),
+        ),
+    }
+)
+
+
+def validate_temperature_inputs(config):
+    if config[CONF_TEMPERATURE_MODE] == "lowest_critical" and not any(
+        conf[CONF_CRITICAL] for conf in config.get(CONF_TEMPERATURE_INPUTS, [])
+    ):
+        raise cv.Invalid(f"'{CONF_TEMPERATURE_MODE}: lowest_critical' needs at least one '{CONF_CRITICAL}' input")
+    return config
+
+
+def compensation_table(key, x_key, x_validator, y_key, y_validator):
+    """2-8 points of a piecewise linear table, sorted by x_key."""
+    point = cv.Schema({cv.Required(x_key): x_validator, cv.Required(y_key): y_validator})
+
+    def validator(value):
+        points = cv.All(cv.ensure_list(point), cv.Length(min=2, max=8))(value)
+        points = sorted(points, key=lambda p: p[x_key])
+        for a, b in zip(points, points[1:]):
+            if a[x_key] == b[x_key]:
+                raise cv.Invalid(f"'{key}' has two points at {x_key} {a[x_key]}")
+        return points
+
+    return validator
+
+
+ALTITUDE_POWER_LIMIT = compensation_table(
+    CONF_ALTITUDE_POWER_LIMIT, CONF_ALTITUDE, cv.float_range(min=-500.0, max=9000.0),
+    CONF_MAX_POWER, cv.All(cv.percentage, cv.Range(min=0.1, max=1.0)),
+)
+FUEL_TEMPERATURE_CORRECTION = compensation_table(
+    CONF_FUEL_TEMPERATURE_CORRECTION, CONF_TEMPERATURE, cv.float_range(min=-50.0, max=80.0),
+    CONF_FACTOR, cv.float_range(min=0.5, max=1.5),
+)
+
+
+def validate_compensation(config):
+    # A table without an input, or an input without a table, would silently do nothing
+    has_altitude = any(key in config for key in (CONF_ALTITUDE, CONF_ALTITUDE_SENSOR, CONF_PRESSURE_SENSOR))
+    if has_altitude != (CONF_ALTITUDE_POWER_LIMIT in config):
+        raise cv.Invalid(
+            f"'{CONF_ALTITUDE_POWER_LIMIT}' and one of '{CONF_ALTITUDE}', '{CONF_ALTITUDE_SENSOR}' "
+            f"or '{CONF_PRESSURE_SENSOR}' are needed together"
+        )
+    if (CONF_FUEL_TEMPERATURE_SENSOR in config) != (CONF_FUEL_TEMPERATURE_CORRECTION in config):
+        raise cv.Invalid(f"'{CONF_FUEL_TEMPERATURE_CORRECTION}' and '{CONF_FUEL_TEMPERATURE_SENSOR}' are needed together")
+    return config
+
+
+def validate_efficiency(value):
+    """One efficiency for all power levels, or one per power level 1-10."""
+    values = cv.ensure_list(cv.percentage)(value)
+    if len(values) == 1:
+        return values * 10
+    if len(values) != 10:
+        raise cv.Invalid(f"'{CONF_EFFICIENCY}' takes one value or one per power level (10), got {len(values)}")
+    return values
+
+
+def validate_status_path(value):
+    value = cv.string_strict(value)
+    if not value.startswith("/") or len(value) < 2:
+        raise cv.Invalid(f"'{CONF_STATUS_PATH}' must start with '/', e.g. /vevor_heater/status")
+    return value
+
+
+def validate_bus(config):
+    controller_id = HEATER_MODELS[config[CONF_MODEL]]["controller_id"]
+    if CONF_DEVICE_ID in config and config[CONF_DEVICE_ID] == controller_id:
+        raise cv.Invalid(f"'{CONF_DEVICE_ID}' 0x{controller_id:02X} is the controller ID")
+    if config[CONF_ADDRESSED_REQUESTS]:
+        if CONF_DEVICE_ID not in config:
+            raise cv.Invalid(f"'{CONF_ADDRESSED_REQUESTS}' needs a '{CONF_DEVICE_ID}'")
+        # Requests carry the controller ID offset by the device ID's distance from the heater ID
+        heater_id = HEATER_MODELS[config[CONF_MODEL]]["heater_id"]
+        address = controller_id + config[CONF_DEVICE_ID] - heater_id
+        if not 0 <= address <= 0xFF:
+            raise cv.Invalid(f"'{CONF_DEVICE_ID}' 0x{config[CONF_DEVICE_ID]:02X} gives no valid request address")
+    return config
+
+
+def final_validate_model(config):
+    # The profile is selected at compile time, so it is one per firmware
+    models = {conf[CONF_MODEL] for conf in fv.full_config.get().get("vevor_heater", [])}
+    if len(models) > 1:
+        raise cv.Invalid(f"All heaters need the same '{CONF_MODEL}', got {', '.join(sorted(models))}")
+    return config
+
+
+def final_validate_bus(config):
+    # Requests only reach one heater unless they are addressed, and addressing is not
+    # confirmed on hardware, so a UART is shared only by heaters that all opt in to it,
+    # with distinct IDs and one slot timeout
+    heaters = [
+        conf for conf in fv.full_config.get().get("vevor_heater", [])
+        if conf[CONF_UART_ID] == config[CONF_UART_ID]
+    ]
+    if len(heaters) < 2:
+        return config
+    ids = []
+    for conf in heaters:
+        if not conf[CONF_ADDRESSED_REQUESTS]:
+            raise cv.Invalid(
+                f"Heaters sharing '{CONF_UART_ID}' {config[CONF_UART_ID]} all need '{CONF_ADDRESSED_REQUESTS}: true': "
+                "addressed requests are not confirmed on hardware yet, or give each heater its own UART"
+            )
+        ids.append(conf[CONF_DEVICE_ID])
+        if conf[CONF_BUS_SLOT_TIMEOUT] != config[CONF_BUS_SLOT_TIMEOUT]:
+            raise cv.Invalid(f"Heaters sharing '{CONF_UART_ID}' {config[CONF_UART_ID]} need the same '{CONF_BUS_SLOT_TIMEOUT}'")
+    if len(set(ids)) != len(ids):
+        raise cv.Invalid(f"Duplicate '{CONF_DEVICE_ID}' on '{CONF_UART_ID}' {config[CONF_UART_ID]}")
+    return config
+
+
+def final_validate_uart_task(config):
+    if CONF_UART_TASK not in config:
+        return config
+    shared = [
+        conf for conf in fv.full_config.get().get("vevor_heater", [])
+        if conf[CONF_UART_ID] == config[CONF_UART_ID]
+    ]
+    if len(shared) > 1:
+        raise cv.Invalid(f"'{CONF_UART_TASK}' cannot be used on a UART shared by several heaters")
+    if config[CONF_UART_TASK][CONF_CORE] == 1 and get_esp32_variant() not in (VARIANT_ESP32, VARIANT_ESP32S3):
+        raise cv.Invalid(f"'{CONF_UART_TASK}' {CONF_CORE} 1 needs a dual-core ESP32")
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = cv.All(final_validate_model, final_validate_bus, final_validate_uart_task)
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(VevorHeater),
             cv.Required(CONF_UART_ID): cv.use_id(uart.UARTComponent),
+            cv.Optional(CONF_MODEL, default="vevor"): cv.one_of(*HEATER_MODELS, lower=True),
             cv.Optional(CONF_AUTO_SENSORS, default=True): cv.boolean,
             cv.Optional(CONF_CONTROL_MODE, default=CONTROL_MODE_MANUAL): cv.enum(
                 {CONTROL_MODE_MANUAL: "manual", CONTROL_MODE_AUTOMATIC: "automatic", CONTROL_MODE_ANTIFREEZE: "antifreeze"},
@@ -159,16 +649,38 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_DEFAULT_POWER_PERCENT, default=80.0): cv.float_range(
                 min=10.0, max=100.0
             ),
-            cv.Optional(CONF_INJECTED_PER_PULSE, default=0.022): cv.float_range(
+            # Model dependent, the profile supplies the default
+            cv.Optional(CONF_INJECTED_PER_PULSE): cv.float_range(
                 min=0.001, max=1.0
             ),
             cv.Optional(CONF_POLLING_INTERVAL, default="60s"): cv.positive_time_period_milliseconds,
+            # Energy accounting: heating value of the fuel and heater efficiency
+            cv.Optional(CONF_HEATING_VALUE, default=9.88): cv.float_range(min=5.0, max=15.0),
+            cv.Optional(CONF_EFFICIENCY, default=0.85): cv.All(validate_efficiency, [cv.float_range(min=0.3, max=1.0)]),
+            cv.Optional(CONF_FUEL_SAVE_INTERVAL, default="30s"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(seconds=5)),
+            ),
             cv.Optional(CONF_TIME_ID): cv.use_id(time.RealTimeClock),
             cv.Optional(CONF_EXTERNAL_TEMPERATURE_SENSOR): cv.use_id(sensor.Sensor),
-            cv.Optional("min_voltage_start", default=12.3): cv.float_range(
+            # Several temperature sensors combined into the control temperature
+            cv.Optional(CONF_TEMPERATURE_INPUTS): cv.All(
+                cv.ensure_list(TEMPERATURE_INPUT_SCHEMA), cv.Length(min=1, max=8)
+            ),
+            cv.Optional(CONF_TEMPERATURE_MODE, default="mean"): cv.one_of(*TEMPERATURE_MODES, lower=True),
+            # Altitude power derating and fuel temperature ml/pulse correction
+            cv.Exclusive(CONF_ALTITUDE, "altitude_source"): cv.float_range(min=-500.0, max=9000.0),
+            cv.Exclusive(CONF_ALTITUDE_SENSOR, "altitude_source"): cv.use_id(sensor.Sensor),
+            cv.Exclusive(CONF_PRESSURE_SENSOR, "altitude_source"): cv.use_id(sensor.Sensor),
+            cv.Optional(CONF_ALTITUDE_POWER_LIMIT): ALTITUDE_POWER_LIMIT,
+            cv.Optional(CONF_FUEL_TEMPERATURE_SENSOR): cv.use_id(sensor.Sensor),
+            cv.Optional(CONF_FUEL_TEMPERATURE_CORRECTION): FUEL_TEMPERATURE_CORRECTION,
+            cv.Optional(CONF_EFFECTIVE_MAX_POWER): SENSOR_SCHEMAS[CONF_EFFECTIVE_MAX_POWER],
+            cv.Optional(CONF_EFFECTIVE_INJECTED_PER_PULSE): SENSOR_SCHEMAS[CONF_EFFECTIVE_INJECTED_PER_PULSE],
+            cv.Optional("min_voltage_start"): cv.float_range(
                 min=10.0, max=15.0
             ),
-            cv.Optional("min_voltage_operate", default=11.4): cv.float_range(
+            cv.Optional("min_voltage_operate"): cv.float_range(
                 min=9.0, max=14.0
             ),
             # Antifreeze mode temperature thresholds
@@ -200,6 +712,147 @@ CONFIG_SCHEMA = cv.All(
             cv.Optional(CONF_HOURLY_CONSUMPTION): SENSOR_SCHEMAS[CONF_HOURLY_CONSUMPTION],
             cv.Optional(CONF_DAILY_CONSUMPTION): SENSOR_SCHEMAS[CONF_DAILY_CONSUMPTION],
             cv.Optional(CONF_TOTAL_CONSUMPTION): SENSOR_SCHEMAS[CONF_TOTAL_CONSUMPTION],
+            cv.Optional(CONF_FUEL_SINCE_REFILL): SENSOR_SCHEMAS[CONF_FUEL_SINCE_REFILL],
+            cv.Optional(CONF_THERMAL_POWER): SENSOR_SCHEMAS[CONF_THERMAL_POWER],
+            cv.Optional(CONF_DAILY_ENERGY): SENSOR_SCHEMAS[CONF_DAILY_ENERGY],
+            cv.Optional(CONF_TOTAL_ENERGY): SENSOR_SCHEMAS[CONF_TOTAL_ENERGY],
+            cv.Optional(CONF_TANK_REMAINING): SENSOR_SCHEMAS[CONF_TANK_REMAINING],
+            cv.Optional(CONF_TANK_LEVEL): SENSOR_SCHEMAS[CONF_TANK_LEVEL],
+            cv.Optional(CONF_TANK_HOURS_LEFT): SENSOR_SCHEMAS[CONF_TANK_HOURS_LEFT],
+            cv.Optional(CONF_LOW_FUEL): SENSOR_SCHEMAS[CONF_LOW_FUEL],
+            # Fuel tank model
+            cv.Optional(CONF_TANK_CAPACITY): cv.float_range(min=0.5, max=500.0),
+            cv.Optional(CONF_LOW_FUEL_THRESHOLD, default=10.0): cv.float_range(
+                min=1.0, max=50.0
+            ),
+            cv.Optional(CONF_LOW_FUEL_SHUTDOWN, default=False): cv.boolean,
+            cv.Optional(CONF_REFILL_TANK_BUTTON): button.button_schema(
+                VevorRefillTankButton,
+                icon="mdi:gas-station",
+                entity_category="config",
+            ),
+            # On-device weekly schedule
+            cv.Optional(CONF_SCHEDULE): cv.All(
+                cv.ensure_list(SCHEDULE_SLOT_SCHEMA), cv.Length(max=8)
+            ),
+            cv.Optional(CONF_SCHEDULE_SWITCH): switch.switch_schema(
+                VevorScheduleSwitch,
+                icon="mdi:calendar-clock",
+                entity_category="config",
+            ),
+            cv.Optional(CONF_SCHEDULE_NEXT_EVENT): SENSOR_SCHEMAS[CONF_SCHEDULE_NEXT_EVENT],
+            cv.Optional(CONF_PREHEAT_LEAD_TIME): SENSOR_SCHEMAS[CONF_PREHEAT_LEAD_TIME],
+            # Fault detection and log
+            cv.Optional(CONF_OVERHEAT_TEMPERATURE): cv.float_range(
+                min=50.0, max=400.0
+            ),
+            cv.Optional(CONF_FAULT_COUNT): SENSOR_SCHEMAS[CONF_FAULT_COUNT],
+            cv.Optional(CONF_LAST_FAULT): SENSOR_SCHEMAS[CONF_LAST_FAULT],
+            cv.Optional(CONF_CONTROLLER_STATE): SENSOR_SCHEMAS[CONF_CONTROLLER_STATE],
+            # Restart policy after failed starts
+            cv.Optional(CONF_MAX_START_FAILURES, default=3): cv.int_range(min=1, max=10),
+            cv.Optional(CONF_RESTART_BACKOFF, default="60s"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(seconds=10)),
+            ),
+            cv.Optional(CONF_MAX_RESTART_BACKOFF, default="30min"): cv.positive_time_period_milliseconds,
+            # Shutdown sequencing
+            cv.Optional(CONF_RESTART_TEMPERATURE, default=60.0): cv.float_range(
+                min=20.0, max=200.0
+            ),
+            cv.Optional(CONF_RESUME_AFTER_REBOOT, default=True): cv.boolean,
+            cv.Optional(CONF_COOLDOWN_TIME): SENSOR_SCHEMAS[CONF_COOLDOWN_TIME],
+            cv.Optional(CONF_FAILED_STARTS): SENSOR_SCHEMAS[CONF_FAILED_STARTS],
+            cv.Optional(CONF_RESTART_BACKOFF_REMAINING): SENSOR_SCHEMAS[CONF_RESTART_BACKOFF_REMAINING],
+            cv.Optional(CONF_RESTART_LOCKOUT): SENSOR_SCHEMAS[CONF_RESTART_LOCKOUT],
+            cv.Optional(CONF_RESET_LOCKOUT_BUTTON): button.button_schema(
+                VevorResetLockoutButton,
+                icon="mdi:lock-reset",
+                entity_category="config",
+            ),
+            cv.Optional(CONF_CLEAR_FAULT_LOG_BUTTON): button.button_schema(
+                VevorClearFaultLogButton,
+                icon="mdi:delete-sweep",
+                entity_category="config",
+            ),
+            # Runtime hour meters and service interval
+            cv.Optional(CONF_SERVICE_INTERVAL): cv.All(
+                cv.Schema(
+                    {
+                        cv.Optional(CONF_BURNER_HOURS_INTERVAL): cv.float_range(min=1.0, max=100000.0),
+                        cv.Optional(CONF_IGNITIONS_INTERVAL): cv.int_range(min=1, max=1000000),
+                    }
+                ),
+                cv.has_at_least_one_key(CONF_BURNER_HOURS_INTERVAL, CONF_IGNITIONS_INTERVAL),
+            ),
+            cv.Optional(CONF_BURNER_HOURS): SENSOR_SCHEMAS[CONF_BURNER_HOURS],
+            cv.Optional(CONF_FAN_HOURS): SENSOR_SCHEMAS[CONF_FAN_HOURS],
+            cv.Optional(CONF_IGNITION_COUNT): SENSOR_SCHEMAS[CONF_IGNITION_COUNT],
+            cv.Optional(CONF_BURNER_HOURS_SINCE_SERVICE): SENSOR_SCHEMAS[CONF_BURNER_HOURS_SINCE_SERVICE],
+            cv.Optional(CONF_IGNITIONS_SINCE_SERVICE): SENSOR_SCHEMAS[CONF_IGNITIONS_SINCE_SERVICE],
+            cv.Optional(CONF_SERVICE_DUE): SENSOR_SCHEMAS[CONF_SERVICE_DUE],
+            cv.Optional(CONF_SERVICE_RESET_BUTTON): button.button_schema(
+                VevorServiceResetButton,
+                icon="mdi:wrench-check",
+                entity_category="config",
+            ),
+            # Command and link latency sensors (p50/p95/max per histogram)
+            cv.Optional(CONF_LATENCY): LATENCY_SCHEMA,
+            # Drop status frames whose checksum fails instead of only logging the mismatch
+            cv.Optional(CONF_REJECT_BAD_CHECKSUM, default=False): cv.boolean,
+            # Heater answering with another ID, replies are matched by the status frame device ID
+            cv.Optional(CONF_DEVICE_ID): cv.hex_uint8_t,
+            # Experimental: offset the request's controller ID by the device ID, unconfirmed on hardware
+            cv.Optional(CONF_ADDRESSED_REQUESTS, default=False): cv.boolean,
+            cv.Optional(CONF_BUS_SLOT_TIMEOUT, default="300ms"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(milliseconds=150), max=cv.TimePeriod(milliseconds=2000)),
+            ),
+            # Dedicated FreeRTOS task owning the UART
+            cv.Optional(CONF_UART_TASK): cv.All(
+                cv.Schema(
+                    {
+                        cv.Optional(CONF_CORE, default=0): cv.int_range(min=0, max=1),
+                        cv.Optional(CONF_PRIORITY, default=5): cv.int_range(min=1, max=20),
+                    }
+                ),
+                cv.only_on_esp32,
+            ),
+            # Cached JSON status snapshot on a web_server route
+            cv.Optional(CONF_STATUS_ENDPOINT): cv.Schema(
+                {
+                    cv.GenerateID(CONF_WEB_SERVER_BASE_ID): cv.use_id(web_server_base.WebServerBase),
+                    cv.Optional(CONF_STATUS_PATH): validate_status_path,
+                }
+            ),
+            # Batched binary MQTT telemetry
+            cv.Optional(CONF_TELEMETRY): cv.All(
+                cv.Schema(
+                    {
+                        cv.Optional(CONF_TELEMETRY_TOPIC): cv.publish_topic,
+                        cv.Optional(CONF_TELEMETRY_INTERVAL, default="60s"): cv.All(
+                            cv.positive_time_period_milliseconds,
+                            cv.Range(min=cv.TimePeriod(seconds=1)),
+                        ),
+                        cv.Optional(CONF_ON_STATE_CHANGE, default=True): cv.boolean,
+                    }
+                ),
+                cv.requires_component("mqtt"),
+            ),
+            # Raw frame capture for protocol reverse engineering
+            cv.Optional(CONF_FRAME_CAPTURE_CAPACITY, default=64): cv.int_range(
+                min=8, max=256
+            ),
+            cv.Optional(CONF_FRAME_CAPTURE_SWITCH): switch.switch_schema(
+                VevorFrameCaptureSwitch,
+                icon="mdi:record-rec",
+                entity_category="diagnostic",
+            ),
+            cv.Optional(CONF_DUMP_FRAME_CAPTURE_BUTTON): button.button_schema(
+                VevorDumpFrameCaptureButton,
+                icon="mdi:text-box-search-outline",
+                entity_category="diagnostic",
+            ),
             # Number component for injected per pulse
             cv.Optional(CONF_INJECTED_PER_PULSE_NUMBER): number.number_schema(
                 VevorInjectedPerPulseNumber,
@@ -217,6 +870,22 @@ CONFIG_SCHEMA = cv.All(
                 icon="mdi:restart",
                 entity_category="config",
             ),
+            # Refill logging for learned pump calibration
+            cv.Optional(CONF_REFILL_VOLUME_NUMBER): number.number_schema(
+                VevorRefillVolumeNumber,
+                unit_of_measurement=UNIT_MILLILITERS,
+                icon="mdi:gas-station",
+                entity_category="config",
+            ).extend({
+                cv.Optional("min_value", default=0.0): cv.float_,
+                cv.Optional("max_value", default=50000.0): cv.float_,
+                cv.Optional("step", default=10.0): cv.float_,
+            }),
+            cv.Optional(CONF_LOG_REFILL_BUTTON): button.button_schema(
+                VevorLogRefillButton,
+                icon="mdi:gas-station",
+                entity_category="config",
+            ),
             # Select for control mode
             cv.Optional(CONF_CONTROL_MODE_SELECT): select.select_schema(
                 VevorControlModeSelect,
@@ -242,6 +911,11 @@ CONFIG_SCHEMA = cv.All(
     )
     .extend(cv.COMPONENT_SCHEMA)
     .extend(cv.polling_component_schema("1s")),
+    validate_tank,
+    validate_schedule,
+    validate_bus,
+    validate_temperature_inputs,
+    validate_compensation,
 )
 
 
@@ -251,6 +925,25 @@ async def to_code(config):
 
     uart_component = await cg.get_variable(config[CONF_UART_ID])
     cg.add(var.set_uart_parent(uart_component))
+    
+    # Heater profile, constexpr data selected at compile time
+    cg.add_define(HEATER_MODELS[config[CONF_MODEL]]["define"])
+    cg.add(var.set_reject_bad_checksum(config[CONF_REJECT_BAD_CHECKSUM]))
+    
+    # Addressed heaters share one bus manager per UART, created by the first of them
+    if CONF_DEVICE_ID in config:
+        cg.add(var.set_device_id(config[CONF_DEVICE_ID]))
+        if config[CONF_ADDRESSED_REQUESTS]:
+            cg.add(var.set_addressed_requests(True))
+        buses = CORE.data.setdefault("vevor_heater_buses", {})
+        bus_key = str(config[CONF_UART_ID])
+        if bus_key not in buses:
+            bus = cg.new_Pvariable(ID(f"vevor_bus_{bus_key}", is_declaration=True, type=VevorBus))
+            await cg.register_component(bus, {})
+            cg.add(bus.set_uart_parent(uart_component))
+            cg.add(bus.set_slot_timeout(config[CONF_BUS_SLOT_TIMEOUT]))
+            buses[bus_key] = bus
+        cg.add(buses[bus_key].add_device(var, config[CONF_DEVICE_ID]))
 
     # Set control mode
     control_mode = config[CONF_CONTROL_MODE]
@@ -264,15 +957,26 @@ async def to_code(config):
     # Set default power percent
     cg.add(var.set_default_power_percent(config[CONF_DEFAULT_POWER_PERCENT]))
     
-    # Set injected per pulse
-    cg.add(var.set_injected_per_pulse(config[CONF_INJECTED_PER_PULSE]))
+    # Set injected per pulse, the profile default otherwise
+    if CONF_INJECTED_PER_PULSE in config:
+        cg.add(var.set_injected_per_pulse(config[CONF_INJECTED_PER_PULSE]))
     
     # Set polling interval
     cg.add(var.set_polling_interval(config[CONF_POLLING_INTERVAL]))
     
-    # Set voltage safety thresholds
-    cg.add(var.set_min_voltage_start(config["min_voltage_start"]))
-    cg.add(var.set_min_voltage_operate(config["min_voltage_operate"]))
+    # Set maximum window of fuel data that may be lost on power failure
+    cg.add(var.set_fuel_save_interval(config[CONF_FUEL_SAVE_INTERVAL]))
+    
+    # Energy accounting
+    cg.add(var.set_heating_value(config[CONF_HEATING_VALUE]))
+    for level, efficiency in enumerate(config[CONF_EFFICIENCY], start=1):
+        cg.add(var.set_heater_efficiency(level, efficiency))
+    
+    # Set voltage safety thresholds, the profile defaults otherwise
+    if "min_voltage_start" in config:
+        cg.add(var.set_min_voltage_start(config["min_voltage_start"]))
+    if "min_voltage_operate" in config:
+        cg.add(var.set_min_voltage_operate(config["min_voltage_operate"]))
     
     # Set antifreeze temperature thresholds
     cg.add(var.set_antifreeze_temp_on(config["antifreeze_temp_on"]))
@@ -280,6 +984,64 @@ async def to_code(config):
     cg.add(var.set_antifreeze_temp_low(config["antifreeze_temp_low"]))
     cg.add(var.set_antifreeze_temp_off(config["antifreeze_temp_off"]))
     
+    # Set fault detection threshold, the profile default otherwise
+    if CONF_OVERHEAT_TEMPERATURE in config:
+        cg.add(var.set_overheat_temperature(config[CONF_OVERHEAT_TEMPERATURE]))
+    
+    # Set restart policy
+    cg.add(var.set_max_start_failures(config[CONF_MAX_START_FAILURES]))
+    cg.add(var.set_restart_backoff(config[CONF_RESTART_BACKOFF]))
+    cg.add(var.set_max_restart_backoff(config[CONF_MAX_RESTART_BACKOFF]))
+    
+    # Set shutdown sequencing
+    cg.add(var.set_restart_temperature(config[CONF_RESTART_TEMPERATURE]))
+    cg.add(var.set_resume_after_reboot(config[CONF_RESUME_AFTER_REBOOT]))
+    
+    # UART on its own task, away from WiFi, API and web server stalls
+    if CONF_UART_TASK in config:
+        uart_task = config[CONF_UART_TASK]
+        cg.add_define("USE_VEVOR_UART_TASK")
+        cg.add(var.set_uart_task(uart_task[CONF_CORE], uart_task[CONF_PRIORITY]))
+    
+    # Status endpoint, one JSON request per heater for fleet monitoring
+    if CONF_STATUS_ENDPOINT in config:
+        endpoint = config[CONF_STATUS_ENDPOINT]
+        base = await cg.get_variable(endpoint[CONF_WEB_SERVER_BASE_ID])
+        path = endpoint.get(CONF_STATUS_PATH, f"/vevor_heater/{config[CONF_ID].id}")
+        cg.add_define("USE_VEVOR_STATUS_ENDPOINT")
+        cg.add(var.set_status_endpoint(base, path))
+    
+    # Binary MQTT telemetry, schema in tools/telemetry_decoder.py
+    if CONF_TELEMETRY in config:
+        telemetry = config[CONF_TELEMETRY]
+        topic = telemetry.get(CONF_TELEMETRY_TOPIC, f"{CORE.name}/vevor_heater/{config[CONF_ID].id}/telemetry")
+        cg.add_define("USE_VEVOR_MQTT_TELEMETRY")
+        cg.add(var.set_telemetry(topic, telemetry[CONF_TELEMETRY_INTERVAL], telemetry[CONF_ON_STATE_CHANGE]))
+    
+    # Set frame capture buffer size (only allocated while capturing)
+    cg.add(var.set_frame_capture_capacity(config[CONF_FRAME_CAPTURE_CAPACITY]))
+    
+    # Set fuel tank model if configured
+    if CONF_TANK_CAPACITY in config:
+        cg.add(var.set_tank_capacity(config[CONF_TANK_CAPACITY]))
+        cg.add(var.set_low_fuel_threshold(config[CONF_LOW_FUEL_THRESHOLD]))
+        cg.add(var.set_low_fuel_shutdown(config[CONF_LOW_FUEL_SHUTDOWN]))
+    
+    # Schedule slots from YAML; the hash lets runtime edits persist until the YAML changes
+    if CONF_SCHEDULE in config:
+        for slot in config[CONF_SCHEDULE]:
+            days = sum(1 << SCHEDULE_DAYS[day] for day in slot[CONF_DAYS])
+            cg.add(var.add_schedule_slot(
+                days,
+                slot[CONF_START],
+                slot[CONF_END],
+                int(slot.get(CONF_POWER, 0)),
+                slot.get(CONF_TARGET_TEMPERATURE, cg.RawExpression("NAN")),
+                PREHEAT_AUTO if slot[CONF_PREHEAT] == "auto" else slot[CONF_PREHEAT].total_minutes,
+            ))
+        schedule_hash = zlib.crc32(repr(config[CONF_SCHEDULE]).encode()) or 1
+        cg.add(var.set_schedule_config_hash(schedule_hash))
+    
     # Set time component if provided
     if CONF_TIME_ID in config:
         time_component = await cg.get_variable(config[CONF_TIME_ID])
@@ -289,7 +1051,55 @@ async def to_code(config):
     if CONF_EXTERNAL_TEMPERATURE_SENSOR in config:
         external_sensor = await cg.get_variable(config[CONF_EXTERNAL_TEMPERATURE_SENSOR])
         cg.add(var.set_external_temperature_sensor(external_sensor))
+    
+    # Multi-zone temperature inputs
+    for conf in config.get(CONF_TEMPERATURE_INPUTS, []):
+        input_sensor = await cg.get_variable(conf[CONF_SENSOR])
+        cg.add(var.add_temperature_input(input_sensor, conf[CONF_WEIGHT], conf[CONF_CRITICAL], conf[CONF_MAX_AGE]))
+    mode = TEMPERATURE_MODES[config[CONF_TEMPERATURE_MODE]]
+    cg.add(var.set_temperature_mode(cg.RawExpression(f"esphome::vevor_heater::AggregationMode::{mode}")))
+
+    # Altitude and fuel temperature compensation
+    if CONF_ALTITUDE in config:
+        cg.add(var.set_altitude(config[CONF_ALTITUDE]))
+    if CONF_ALTITUDE_SENSOR in config:
+        cg.add(var.set_altitude_sensor(await cg.get_variable(config[CONF_ALTITUDE_SENSOR])))
+    if CONF_PRESSURE_SENSOR in config:
+        cg.add(var.set_pressure_sensor(await cg.get_variable(config[CONF_PRESSURE_SENSOR])))
+    for point in config.get(CONF_ALTITUDE_POWER_LIMIT, []):
+        cg.add(var.add_altitude_power_limit(point[CONF_ALTITUDE], point[CONF_MAX_POWER] * 100.0))
+    if CONF_FUEL_TEMPERATURE_SENSOR in config:
+        cg.add(var.set_fuel_temperature_sensor(await cg.get_variable(config[CONF_FUEL_TEMPERATURE_SENSOR])))
+    for point in config.get(CONF_FUEL_TEMPERATURE_CORRECTION, []):
+        cg.add(var.add_fuel_temperature_correction(point[CONF_TEMPERATURE], point[CONF_FACTOR]))
 
+    # Service interval thresholds, either one raises service due
+    if CONF_SERVICE_INTERVAL in config:
+        interval = config[CONF_SERVICE_INTERVAL]
+        if CONF_BURNER_HOURS_INTERVAL in interval:
+            cg.add(var.set_service_interval_hours(interval[CONF_BURNER_HOURS_INTERVAL]))
+        if CONF_IGNITIONS_INTERVAL in interval:
+            cg.add(var.set_service_interval_ignitions(interval[CONF_IGNITIONS_INTERVAL]))
+
+    # Latency histograms are always kept, sensors only where configured
+    for metric, metric_enum in LATENCY_METRICS.items():
+        for stat, stat_enum in LATENCY_STATS.items():
+            stat_config = config.get(CONF_LATENCY, {}).get(metric, {}).get(stat)
+            if stat_config is None:
+                continue
+            sens = await sensor.new_sensor(stat_config)
+            cg.add(var.set_latency_sensor(
+                cg.RawExpression(f"esphome::vevor_heater::LatencyMetric::{metric_enum}"),
+                cg.RawExpression(f"esphome::vevor_heater::LatencyStat::{stat_enum}"),
+                sens,
+            ))
+
+    # Every heater but the default one gets its ID in the automatic entity names
+    name_prefix = "Vevor Heater"
+    heater_id = HEATER_MODELS[config[CONF_MODEL]]["heater_id"]
+    if config.get(CONF_DEVICE_ID, heater_id) != heater_id:
+        name_prefix = f"Vevor Heater {config[CONF_DEVICE_ID]:02X}"
+    
     # Auto-create sensors if enabled
     if config[CONF_AUTO_SENSORS]:
         sensors_to_create = [
@@ -304,17 +1114,58 @@ async def to_code(config):
             (CONF_HOURLY_CONSUMPTION, "set_hourly_consumption_sensor"),
             (CONF_DAILY_CONSUMPTION, "set_daily_consumption_sensor"),
             (CONF_TOTAL_CONSUMPTION, "set_total_consumption_sensor"),
+            (CONF_FUEL_SINCE_REFILL, "set_fuel_since_refill_sensor"),
+            (CONF_THERMAL_POWER, "set_thermal_power_sensor"),
+            (CONF_DAILY_ENERGY, "set_daily_energy_sensor"),
+            (CONF_TOTAL_ENERGY, "set_total_energy_sensor"),
+            (CONF_FAULT_COUNT, "set_fault_count_sensor"),
+            (CONF_FAILED_STARTS, "set_failed_starts_sensor"),
+            (CONF_RESTART_BACKOFF_REMAINING, "set_restart_backoff_sensor"),
+            (CONF_COOLDOWN_TIME, "set_cooldown_time_sensor"),
+            (CONF_BURNER_HOURS, "set_burner_hours_sensor"),
+            (CONF_FAN_HOURS, "set_fan_hours_sensor"),
+            (CONF_IGNITION_COUNT, "set_ignition_count_sensor"),
         ]
 
         text_sensors_to_create = [
             (CONF_STATE, "set_state_sensor"),
+            (CONF_LAST_FAULT, "set_last_fault_sensor"),
+            (CONF_CONTROLLER_STATE, "set_controller_state_sensor"),
         ]
 
         binary_sensors_to_create = [
             (CONF_COOLING_DOWN, "set_cooling_down_sensor"),
             (CONF_LOW_VOLTAGE_ERROR, "set_low_voltage_error_sensor"),
+            (CONF_RESTART_LOCKOUT, "set_restart_lockout_sensor"),
         ]
 
+        # Tank sensors are only created when a tank is configured
+        if CONF_TANK_CAPACITY in config:
+            sensors_to_create += [
+                (CONF_TANK_REMAINING, "set_tank_remaining_sensor"),
+                (CONF_TANK_LEVEL, "set_tank_level_sensor"),
+                (CONF_TANK_HOURS_LEFT, "set_tank_hours_left_sensor"),
+            ]
+            binary_sensors_to_create.append((CONF_LOW_FUEL, "set_low_fuel_sensor"))
+
+        # Preheat prediction learns from the external temperature sensor
+        if CONF_EXTERNAL_TEMPERATURE_SENSOR in config or CONF_TEMPERATURE_INPUTS in config:
+            sensors_to_create.append((CONF_PREHEAT_LEAD_TIME, "set_preheat_lead_time_sensor"))
+
+        # Effective values only when compensation is configured
+        if CONF_ALTITUDE_POWER_LIMIT in config:
+            sensors_to_create.append((CONF_EFFECTIVE_MAX_POWER, "set_effective_max_power_sensor"))
+        if CONF_FUEL_TEMPERATURE_CORRECTION in config:
+            sensors_to_create.append((CONF_EFFECTIVE_INJECTED_PER_PULSE, "set_effective_injected_per_pulse_sensor"))
+
+        # Since-service counters only with a service interval
+        if CONF_SERVICE_INTERVAL in config:
+            sensors_to_create += [
+                (CONF_BURNER_HOURS_SINCE_SERVICE, "set_burner_hours_since_service_sensor"),
+                (CONF_IGNITIONS_SINCE_SERVICE, "set_ignitions_since_service_sensor"),
+            ]
+            binary_sensors_to_create.append((CONF_SERVICE_DUE, "set_service_due_sensor"))
+
         # Create regular sensors
         for sensor_key, setter_method in sensors_to_create:
             if sensor_key in config:
@@ -324,7 +1175,7 @@ async def to_code(config):
                 # Use default configuration with automatic naming and ID
                 sens_config = {
                     CONF_ID: cg.RawExpression(f"{config[CONF_ID]}_sensor_{sensor_key}"),
-                    CONF_NAME: f"Vevor Heater {sensor_key.replace('_', ' ').title()}"
+                    CONF_NAME: f"{name_prefix} {sensor_key.replace('_', ' ').title()}"
                 }
                 # Apply the schema to get proper defaults
                 sens_config = SENSOR_SCHEMAS[sensor_key](sens_config)
@@ -339,7 +1190,7 @@ async def to_code(config):
             else:
                 sens_config = {
                     CONF_ID: cg.RawExpression(f"{config[CONF_ID]}_text_sensor_{sensor_key}"),
-                    CONF_NAME: f"Vevor Heater {sensor_key.replace('_', ' ').title()}"
+                    CONF_NAME: f"{name_prefix} {sensor_key.replace('_', ' ').title()}"
                 }
                 sens_config = SENSOR_SCHEMAS[sensor_key](sens_config)
             
@@ -353,7 +1204,7 @@ async def to_code(config):
             else:
                 sens_config = {
                     CONF_ID: cg.RawExpression(f"{config[CONF_ID]}_binary_sensor_{sensor_key}"),
-                    CONF_NAME: f"Vevor Heater {sensor_key.replace('_', ' ').title()}"
+                    CONF_NAME: f"{name_prefix} {sensor_key.replace('_', ' ').title()}"
                 }
                 sens_config = SENSOR_SCHEMAS[sensor_key](sens_config)
             
@@ -373,9 +1224,33 @@ async def to_code(config):
             (CONF_HOURLY_CONSUMPTION, "set_hourly_consumption_sensor", sensor.new_sensor),
             (CONF_DAILY_CONSUMPTION, "set_daily_consumption_sensor", sensor.new_sensor),
             (CONF_TOTAL_CONSUMPTION, "set_total_consumption_sensor", sensor.new_sensor),
+            (CONF_FUEL_SINCE_REFILL, "set_fuel_since_refill_sensor", sensor.new_sensor),
+            (CONF_THERMAL_POWER, "set_thermal_power_sensor", sensor.new_sensor),
+            (CONF_DAILY_ENERGY, "set_daily_energy_sensor", sensor.new_sensor),
+            (CONF_TOTAL_ENERGY, "set_total_energy_sensor", sensor.new_sensor),
+            (CONF_EFFECTIVE_MAX_POWER, "set_effective_max_power_sensor", sensor.new_sensor),
+            (CONF_EFFECTIVE_INJECTED_PER_PULSE, "set_effective_injected_per_pulse_sensor", sensor.new_sensor),
+            (CONF_TANK_REMAINING, "set_tank_remaining_sensor", sensor.new_sensor),
+            (CONF_TANK_LEVEL, "set_tank_level_sensor", sensor.new_sensor),
+            (CONF_TANK_HOURS_LEFT, "set_tank_hours_left_sensor", sensor.new_sensor),
+            (CONF_PREHEAT_LEAD_TIME, "set_preheat_lead_time_sensor", sensor.new_sensor),
+            (CONF_FAULT_COUNT, "set_fault_count_sensor", sensor.new_sensor),
+            (CONF_FAILED_STARTS, "set_failed_starts_sensor", sensor.new_sensor),
+            (CONF_RESTART_BACKOFF_REMAINING, "set_restart_backoff_sensor", sensor.new_sensor),
+            (CONF_COOLDOWN_TIME, "set_cooldown_time_sensor", sensor.new_sensor),
+            (CONF_BURNER_HOURS, "set_burner_hours_sensor", sensor.new_sensor),
+            (CONF_FAN_HOURS, "set_fan_hours_sensor", sensor.new_sensor),
+            (CONF_IGNITION_COUNT, "set_ignition_count_sensor", sensor.new_sensor),
+            (CONF_BURNER_HOURS_SINCE_SERVICE, "set_burner_hours_since_service_sensor", sensor.new_sensor),
+            (CONF_IGNITIONS_SINCE_SERVICE, "set_ignitions_since_service_sensor", sensor.new_sensor),
+            (CONF_LAST_FAULT, "set_last_fault_sensor", text_sensor.new_text_sensor),
             (CONF_STATE, "set_state_sensor", text_sensor.new_text_sensor),
+            (CONF_CONTROLLER_STATE, "set_controller_state_sensor", text_sensor.new_text_sensor),
             (CONF_COOLING_DOWN, "set_cooling_down_sensor", binary_sensor.new_binary_sensor),
             (CONF_LOW_VOLTAGE_ERROR, "set_low_voltage_error_sensor", binary_sensor.new_binary_sensor),
+            (CONF_LOW_FUEL, "set_low_fuel_sensor", binary_sensor.new_binary_sensor),
+            (CONF_RESTART_LOCKOUT, "set_restart_lockout_sensor", binary_sensor.new_binary_sensor),
+            (CONF_SERVICE_DUE, "set_service_due_sensor", binary_sensor.new_binary_sensor),
         ]
 
         for sensor_key, setter_method, new_sensor_func in sensor_configs:
@@ -395,6 +1270,48 @@ async def to_code(config):
         btn = await button.new_button(config[CONF_RESET_TOTAL_CONSUMPTION_BUTTON])
         cg.add(btn.set_vevor_heater(var))
     
+    # Refill logging components
+    if CONF_REFILL_VOLUME_NUMBER in config:
+        num_config = config[CONF_REFILL_VOLUME_NUMBER]
+        num = await number.new_number(num_config, min_value=num_config["min_value"], max_value=num_config["max_value"], step=num_config["step"])
+        cg.add(num.set_vevor_heater(var))
+    
+    if CONF_LOG_REFILL_BUTTON in config:
+        btn = await button.new_button(config[CONF_LOG_REFILL_BUTTON])
+        cg.add(btn.set_vevor_heater(var))
+    
+    if CONF_REFILL_TANK_BUTTON in config:
+        btn = await button.new_button(config[CONF_REFILL_TANK_BUTTON])
+        cg.add(btn.set_vevor_heater(var))
+    
+    if CONF_CLEAR_FAULT_LOG_BUTTON in config:
+        btn = await button.new_button(config[CONF_CLEAR_FAULT_LOG_BUTTON])
+        cg.add(btn.set_vevor_heater(var))
+    
+    if CONF_RESET_LOCKOUT_BUTTON in config:
+        btn = await button.new_button(config[CONF_RESET_LOCKOUT_BUTTON])
+        cg.add(btn.set_vevor_heater(var))
+    
+    if CONF_SERVICE_RESET_BUTTON in config:
+        btn = await button.new_button(config[CONF_SERVICE_RESET_BUTTON])
+        cg.add(btn.set_vevor_heater(var))
+    
+    if CONF_FRAME_CAPTURE_SWITCH in config:
+        sw = await switch.new_switch(config[CONF_FRAME_CAPTURE_SWITCH])
+        cg.add(sw.set_vevor_heater(var))
+    
+    if CONF_DUMP_FRAME_CAPTURE_BUTTON in config:
+        btn = await button.new_button(config[CONF_DUMP_FRAME_CAPTURE_BUTTON])
+        cg.add(btn.set_vevor_heater(var))
+    
+    if CONF_SCHEDULE_SWITCH in config:
+        sw = await switch.new_switch(config[CONF_SCHEDULE_SWITCH])
+        cg.add(sw.set_vevor_heater(var))
+    
+    if CONF_SCHEDULE_NEXT_EVENT in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_SCHEDULE_NEXT_EVENT])
+        cg.add(var.set_schedule_next_event_sensor(sens))
+    
     # Select component for control mode
     if CONF_CONTROL_MODE_SELECT in config:
         sel = await select.new_select(config[CONF_CONTROL_MODE_SELECT], options=["Manual", "Antifreeze"])  # "Automatic" commented out
@@ -0,0 +1,108 @@
+#include "bus_scheduler.h"
+
+namespace esphome {
+namespace vevor_heater {
+
+int BusScheduler::add_device(uint8_t device_id) {
+  Device device;
+  device.device_id = device_id;
+  devices_.push_back(device);
+  return static_cast<int>(devices_.size()) - 1;
+}
+
+int BusScheduler::check_timeout(uint32_t now) {
+  if (slot_device_ == NO_SLOT || now - slot_start_ < slot_timeout_ms_) {
+    return NO_SLOT;
+  }
+  int index = slot_device_;
+  devices_[index].stats.timeouts++;
+  slot_device_ = NO_SLOT;
+  last_activity_ = now;
+  return index;
+}
+
+bool BusScheduler::can_open_slot(uint32_t now, bool line_busy) const {
+  return slot_device_ == NO_SLOT && !line_busy && now - last_activity_ >= BUS_GUARD_TIME_MS;
+}
+
+int BusScheduler::select_next_device(uint32_t now, const std::vector<BusDeviceState> &states) const {
+  int best = NO_SLOT;
+  BusPriority best_priority = BusPriority::IDLE;
+  uint32_t best_overdue = 0;
+
+  for (size_t i = 0; i < devices_.size() && i < states.size(); i++) {
+    const Device &device = devices_[i];
+    BusPriority priority = states[i].priority;
+    uint32_t interval = states[i].poll_interval_ms;
+    uint32_t overdue;
+    if (!device.polled) {
+      overdue = UINT32_MAX;  // Never polled, learn its state first
+    } else {
+      uint32_t elapsed = now - device.last_poll;
+      if (elapsed < interval) {
+        continue;
+      }
+      overdue = elapsed - interval;
+    }
+    // Aging: a device kept waiting a whole extra interval is served like a transitional one,
+    // so a saturated bus slows idle devices down instead of starving them
+    if (overdue >= interval) {
+      priority = BusPriority::TRANSITIONAL;
+    }
+
+    // Transitional devices first, then the one that has waited longest past its interval
+    if (best == NO_SLOT || priority > best_priority || (priority == best_priority && overdue > best_overdue)) {
+      best = static_cast<int>(i);
+      best_priority = priority;
+      best_overdue = overdue;
+    }
+  }
+  return best;
+}
+
+void BusScheduler::open_slot(int index, uint32_t now) {
+  Device &device = devices_[index];
+  device.stats.requests++;
+  device.last_poll = now;
+  device.polled = true;
+  slot_device_ = index;
+  slot_start_ = now;
+}
+
+int BusScheduler::handle_reply(uint8_t device_id, uint32_t now, bool *late) {
+  int index = find_device(device_id);
+  if (index == NO_SLOT) {
+    unknown_frames_++;
+    return NO_SLOT;
+  }
+
+  Device &device = devices_[index];
+  *late = index != slot_device_;
+  if (*late) {
+    // Reply to an earlier slot that already timed out, the data is still current
+    device.stats.late_responses++;
+    return index;
+  }
+  uint32_t latency = now - slot_start_;
+  device.stats.responses++;
+  device.stats.last_latency_ms = latency;
+  device.stats.total_latency_ms += latency;
+  if (latency > device.stats.max_latency_ms) {
+    device.stats.max_latency_ms = latency;
+  }
+  slot_device_ = NO_SLOT;
+  last_activity_ = now;
+  return index;
+}
+
+int BusScheduler::find_device(uint8_t device_id) const {
+  for (size_t i = 0; i < devices_.size(); i++) {
+    if (devices_[i].device_id == device_id) {
+      return static_cast<int>(i);
+    }
+  }
+  return NO_SLOT;
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace vevor_heater {
+
+static const uint32_t DEFAULT_BUS_SLOT_TIMEOUT_MS = 300;  // Request + 56 byte reply at 4800 baud with margin
+static const uint32_t BUS_GUARD_TIME_MS = 20;             // Line quiet time before the next request
+
+// Per device link statistics
+struct BusLinkStats {
+  uint32_t requests{0};
+  uint32_t responses{0};
+  uint32_t timeouts{0};
+  uint32_t late_responses{0};  // Answered after its slot closed, still delivered by ID
+  uint32_t last_latency_ms{0};
+  uint32_t max_latency_ms{0};
+  uint64_t total_latency_ms{0};
+};
+
+// Polling priority, higher classes are served first when several devices are due
+enum class BusPriority : uint8_t {
+  IDLE = 0,          // Off, slow status polling
+  ACTIVE = 1,        // Running steadily
+  TRANSITIONAL = 2,  // Starting, stopping or cooling - state changes need fast polling
+};
+
+// What the scheduler asks of each device when it picks the next slot
+struct BusDeviceState {
+  BusPriority priority;
+  uint32_t poll_interval_ms;
+};
+
+// Slot arbitration for one half-duplex line, without the UART: one request per slot,
+// a guard time between slots, replies matched by slot and device ID, timeouts for
+// slots nobody answers. The next device is chosen by priority class and then by how
+// overdue it is; a device kept waiting a whole extra interval is promoted, so a
+// saturated line slows idle devices down instead of starving them. VevorBus owns the
+// UART and the heaters, the host tests drive this class directly.
+class BusScheduler {
+ public:
+  static const int NO_SLOT = -1;
+
+  // Returns the device's index
+  int add_device(uint8_t device_id);
+  void set_slot_timeout(uint32_t timeout_ms) { slot_timeout_ms_ = timeout_ms; }
+  // The first slot opens a guard time after this
+  void start(uint32_t now) { last_activity_ = now; }
+
+  // Closes a slot nobody answered, returns its device or NO_SLOT
+  int check_timeout(uint32_t now);
+  // No slot open, the line quiet and the guard time over
+  bool can_open_slot(uint32_t now, bool line_busy) const;
+  // Device to poll next, NO_SLOT when none is due; states holds one entry per device
+  int select_next_device(uint32_t now, const std::vector<BusDeviceState> &states) const;
+  void open_slot(int index, uint32_t now);
+  // Status frame from device_id, returns its index or NO_SLOT for an unknown device.
+  // late is set when the reply missed its slot.
+  int handle_reply(uint8_t device_id, uint32_t now, bool *late);
+  void count_echo() { echoes_++; }
+
+  bool slot_open() const { return slot_device_ != NO_SLOT; }
+  int slot_device() const { return slot_device_; }
+  uint32_t slot_timeout() const { return slot_timeout_ms_; }
+  size_t device_count() const { return devices_.size(); }
+  uint8_t device_id(size_t index) const { return devices_[index].device_id; }
+  const BusLinkStats &stats(size_t index) const { return devices_[index].stats; }
+  uint32_t echoes() const { return echoes_; }
+  uint32_t unknown_frames() const { return unknown_frames_; }
+
+ protected:
+  struct Device {
+    uint8_t device_id;
+    uint32_t last_poll{0};
+    bool polled{false};
+    BusLinkStats stats;
+  };
+
+  int find_device(uint8_t device_id) const;
+
+  std::vector<Device> devices_;
+  uint32_t slot_timeout_ms_{DEFAULT_BUS_SLOT_TIMEOUT_MS};
+  int slot_device_{NO_SLOT};
+  uint32_t slot_start_{0};
+  uint32_t last_activity_{0};
+  uint32_t echoes_{0};
+  uint32_t unknown_frames_{0};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,88 @@
+#include "compensation.h"
+#include "esphome/core/log.h"
+#include <algorithm>
+
+namespace esphome {
+namespace vevor_heater {
+
+bool InterpolationTable::add_point(float x, float y) {
+  if (size_ >= MAX_COMPENSATION_POINTS || (size_ > 0 && x <= x_[size_ - 1])) {
+    return false;
+  }
+  x_[size_] = x;
+  y_[size_] = y;
+  size_++;
+  return true;
+}
+
+float InterpolationTable::lookup(float x, float fallback) const {
+  if (size_ == 0 || std::isnan(x)) {
+    return fallback;
+  }
+  if (x <= x_[0]) {
+    return y_[0];
+  }
+  for (uint8_t i = 1; i < size_; i++) {
+    if (x <= x_[i]) {
+      float t = (x - x_[i - 1]) / (x_[i] - x_[i - 1]);
+      return y_[i - 1] + t * (y_[i] - y_[i - 1]);
+    }
+  }
+  return y_[size_ - 1];
+}
+
+void Compensation::set_altitude_sensor(sensor::Sensor *sensor) {
+  altitude_source_ = "altitude sensor";
+  sensor->add_on_state_callback([this](float value) {
+    if (!std::isnan(value)) {
+      altitude_ = value;
+    }
+  });
+}
+
+void Compensation::set_pressure_sensor(sensor::Sensor *sensor) {
+  altitude_source_ = "pressure sensor";
+  sensor->add_on_state_callback([this](float value) {
+    if (!std::isnan(value) && value > 0.0f) {
+      altitude_ = pressure_to_altitude(value);
+    }
+  });
+}
+
+void Compensation::set_fuel_temperature_sensor(sensor::Sensor *sensor) {
+  sensor->add_on_state_callback([this](float value) {
+    if (!std::isnan(value)) {
+      fuel_temperature_ = value;
+    }
+  });
+}
+
+uint8_t Compensation::max_power_level() const {
+  // Round down, a limit between two levels must not be exceeded
+  int level = static_cast<int>(max_power_percent() / 10.0f + 0.001f);
+  return static_cast<uint8_t>(std::max(1, std::min(10, level)));
+}
+
+float Compensation::pressure_to_altitude(float pressure_hpa) {
+  return 44330.0f * (1.0f - std::pow(pressure_hpa / 1013.25f, 0.1903f));
+}
+
+void Compensation::dump_config(const char *tag) const {
+  if (has_altitude_limit()) {
+    ESP_LOGCONFIG(tag, "  Altitude Compensation: %s, %.0f m, max power %.0f%%", altitude_source_, altitude_,
+                  max_power_percent());
+    for (uint8_t i = 0; i < power_limit_.size(); i++) {
+      ESP_LOGCONFIG(tag, "    %5.0f m: %.0f%%", power_limit_.x(i), power_limit_.y(i));
+    }
+  }
+  if (has_fuel_correction()) {
+    ESP_LOGCONFIG(tag, "  Fuel Temperature Compensation: %.1f°C, ml/pulse x%.3f", fuel_temperature_,
+                  injected_factor());
+    for (uint8_t i = 0; i < fuel_correction_.size(); i++) {
+      ESP_LOGCONFIG(tag, "    %5.1f°C: x%.3f", fuel_correction_.x(i), fuel_correction_.y(i));
+    }
+  }
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "esphome/components/sensor/sensor.h"
+#include <cmath>
+#include <cstdint>
+
+namespace esphome {
+namespace vevor_heater {
+
+static const uint8_t MAX_COMPENSATION_POINTS = 8;
+static const float MAX_POWER_PERCENT = 100.0f;
+
+// Piecewise linear lookup, held flat beyond the first and last point. Points are
+// added in ascending x (the YAML validation sorts them).
+class InterpolationTable {
+ public:
+  bool add_point(float x, float y);
+  // fallback when the table is empty or x is unknown
+  float lookup(float x, float fallback) const;
+  bool empty() const { return size_ == 0; }
+  uint8_t size() const { return size_; }
+  float x(uint8_t i) const { return x_[i]; }
+  float y(uint8_t i) const { return y_[i]; }
+
+ protected:
+  float x_[MAX_COMPENSATION_POINTS];
+  float y_[MAX_COMPENSATION_POINTS];
+  uint8_t size_{0};
+};
+
+// Site and fuel corrections. Thin air at altitude makes combustion rich, so the highest
+// power level is derated from an altitude table; cold, thick fuel changes what a pump
+// stroke delivers, so ml/pulse is scaled from a fuel temperature table. Altitude comes
+// from a fixed value, an altitude sensor or a pressure sensor. A sensor that goes
+// unknown keeps its last value, the site does not move that fast.
+class Compensation {
+ public:
+  void set_altitude(float altitude) { altitude_ = altitude; }
+  void set_altitude_sensor(sensor::Sensor *sensor);
+  void set_pressure_sensor(sensor::Sensor *sensor);
+  void set_fuel_temperature_sensor(sensor::Sensor *sensor);
+  InterpolationTable &power_limit() { return power_limit_; }
+  InterpolationTable &fuel_correction() { return fuel_correction_; }
+
+  float altitude() const { return altitude_; }  // m, NAN until known
+  float fuel_temperature() const { return fuel_temperature_; }  // °C, NAN until known
+  // Highest power level 1-10 the heater may run at, 10 without altitude data
+  uint8_t max_power_level() const;
+  float max_power_percent() const { return power_limit_.lookup(altitude_, MAX_POWER_PERCENT); }
+  // Factor on ml/pulse, 1 without fuel temperature data
+  float injected_factor() const { return fuel_correction_.lookup(fuel_temperature_, 1.0f); }
+  bool has_altitude_limit() const { return !power_limit_.empty(); }
+  bool has_fuel_correction() const { return !fuel_correction_.empty(); }
+
+  // Standard atmosphere, hPa to m
+  static float pressure_to_altitude(float pressure_hpa);
+  void dump_config(const char *tag) const;
+
+ protected:
+  InterpolationTable power_limit_;
+  InterpolationTable fuel_correction_;
+  float altitude_{NAN};
+  float fuel_temperature_{NAN};
+  const char *altitude_source_{"fixed"};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
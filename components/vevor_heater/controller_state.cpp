@@ -0,0 +1,152 @@
+#include "controller_state.h"
+#include <algorithm>
+
+namespace esphome {
+namespace vevor_heater {
+
+using S = ControllerState;
+using G = ControllerGuard;
+
+// Next state per [state][event], columns in ControllerEvent order:
+// START, STOP, HEATER_OFF, HEATER_IGNITING, HEATER_RUNNING, HEATER_COOLING, LOW_VOLTAGE, VOLTAGE_OK, RESET,
+// RESTART_LIMIT
+static const ControllerTransition TRANSITIONS[CONTROLLER_STATE_COUNT][CONTROLLER_EVENT_COUNT] = {
+    // IDLE - a heater that is burning without a request (e.g. after a controller reboot) is stopped
+    {{S::STARTING, G::START_PERMITTED}, {S::IDLE}, {S::IDLE}, {S::STOPPING}, {S::STOPPING}, {S::STOPPING},
+     {S::IDLE}, {S::IDLE}, {S::IDLE}, {S::LOCKOUT}},
+    // STARTING - stopping after ignition began is a failed start, a report from an earlier cooldown is not
+    {{S::STARTING}, {S::STOPPING}, {S::FAULT, G::WAS_ACTIVE}, {S::STARTING}, {S::RUNNING},
+     {S::FAULT, G::WAS_ACTIVE}, {S::LOCKOUT}, {S::STARTING}, {S::STARTING}, {S::LOCKOUT}},
+    // RUNNING - falling back to heating up is a flame out the heater retries itself
+    {{S::RUNNING}, {S::STOPPING}, {S::FAULT}, {S::STARTING}, {S::RUNNING}, {S::FAULT}, {S::LOCKOUT}, {S::RUNNING},
+     {S::RUNNING}, {S::LOCKOUT}},
+    // STOPPING
+    {{S::STARTING, G::START_PERMITTED}, {S::STOPPING}, {S::IDLE}, {S::STOPPING}, {S::STOPPING}, {S::STOPPING},
+     {S::STOPPING}, {S::STOPPING}, {S::STOPPING}, {S::LOCKOUT}},
+    // LOCKOUT - keeps the heater stopped until the supply recovers (unless latched) or the user resets
+    {{S::LOCKOUT, G::REJECT}, {S::LOCKOUT}, {S::LOCKOUT}, {S::LOCKOUT}, {S::LOCKOUT}, {S::LOCKOUT}, {S::LOCKOUT},
+     {S::IDLE, G::NOT_LATCHED}, {S::IDLE}, {S::LOCKOUT}},
+    // FAULT - held until a new start or stop request acknowledges it
+    {{S::STARTING, G::START_PERMITTED}, {S::STOPPING}, {S::FAULT}, {S::FAULT}, {S::FAULT}, {S::FAULT}, {S::FAULT},
+     {S::FAULT}, {S::IDLE}, {S::LOCKOUT}},
+};
+
+using R = ControllerRequest;
+
+// Request per [state][heater phase], columns HEATER_OFF, HEATER_IGNITING, HEATER_RUNNING, HEATER_COOLING.
+// A stop is only sent while the heater burns; a cooling heater is left to finish on its own.
+static const ControllerRequest REQUESTS[CONTROLLER_STATE_COUNT][4] = {
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // IDLE
+    {R::START, R::RUN, R::RUN, R::RUN},        // STARTING
+    {R::START, R::RUN, R::RUN, R::RUN},        // RUNNING
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // STOPPING
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // LOCKOUT
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // FAULT
+};
+
+bool ControllerStateMachine::dispatch(ControllerEvent event) {
+  const ControllerTransition &transition =
+      TRANSITIONS[static_cast<uint8_t>(state_)][static_cast<uint8_t>(event)];
+  bool accepted = check_guard(transition.guard);
+
+  // The heater phase is tracked even when the state does not change, guards see the previous one
+  if (is_heater_event(event)) {
+    heater_phase_ = event;
+  } else if (event == ControllerEvent::RESTART_LIMIT) {
+    latched_ = true;
+  } else if (event == ControllerEvent::RESET) {
+    latched_ = false;
+  }
+  if (!accepted) {
+    return false;
+  }
+
+  if (transition.next != state_) {
+    ControllerState from = state_;
+    state_ = transition.next;
+    if (on_transition_) {
+      on_transition_(from, state_, event);
+    }
+  }
+  return true;
+}
+
+bool ControllerStateMachine::check_guard(ControllerGuard guard) const {
+  switch (guard) {
+    case ControllerGuard::NONE:
+      return true;
+    case ControllerGuard::START_PERMITTED:
+      return !start_guard_ || start_guard_();
+    case ControllerGuard::WAS_ACTIVE:
+      return heater_phase_ == ControllerEvent::HEATER_IGNITING || heater_phase_ == ControllerEvent::HEATER_RUNNING;
+    case ControllerGuard::NOT_LATCHED:
+      return !latched_;
+    case ControllerGuard::REJECT:
+    default:
+      return false;
+  }
+}
+
+ControllerRequest ControllerStateMachine::request() const {
+  uint8_t phase = static_cast<uint8_t>(heater_phase_) - static_cast<uint8_t>(ControllerEvent::HEATER_OFF);
+  return REQUESTS[static_cast<uint8_t>(state_)][phase];
+}
+
+const char *ControllerStateMachine::state_to_string(ControllerState state) {
+  switch (state) {
+    case ControllerState::IDLE: return "Idle";
+    case ControllerState::STARTING: return "Starting";
+    case ControllerState::RUNNING: return "Running";
+    case ControllerState::STOPPING: return "Stopping";
+    case ControllerState::LOCKOUT: return "Lockout";
+    case ControllerState::FAULT: return "Fault";
+    default: return "Unknown";
+  }
+}
+
+const char *ControllerStateMachine::event_to_string(ControllerEvent event) {
+  switch (event) {
+    case ControllerEvent::START_REQUEST: return "start request";
+    case ControllerEvent::STOP_REQUEST: return "stop request";
+    case ControllerEvent::HEATER_OFF: return "heater off";
+    case ControllerEvent::HEATER_IGNITING: return "heater igniting";
+    case ControllerEvent::HEATER_RUNNING: return "heater running";
+    case ControllerEvent::HEATER_COOLING: return "heater cooling";
+    case ControllerEvent::LOW_VOLTAGE: return "low voltage";
+    case ControllerEvent::VOLTAGE_OK: return "voltage ok";
+    case ControllerEvent::RESET: return "reset";
+    case ControllerEvent::RESTART_LIMIT: return "restart limit";
+    default: return "unknown";
+  }
+}
+
+bool RestartPolicy::record_failure(uint32_t now) {
+  if (failures_ < UINT8_MAX) {
+    failures_++;
+  }
+  // Doubles per consecutive failure: base, 2x base, 4x base ... capped
+  uint32_t backoff = base_backoff_ms_;
+  for (uint8_t i = 1; i < failures_ && backoff < max_backoff_ms_; i++) {
+    backoff *= 2;
+  }
+  backoff_ms_ = std::min(backoff, max_backoff_ms_);
+  last_failure_ = now;
+  return is_limit_reached();
+}
+
+void RestartPolicy::restore(uint8_t failures, uint32_t backoff_remaining_ms, uint32_t now) {
+  failures_ = failures;
+  backoff_ms_ = failures > 0 ? backoff_remaining_ms : 0;
+  last_failure_ = now;
+}
+
+uint32_t RestartPolicy::backoff_remaining(uint32_t now) const {
+  if (failures_ == 0) {
+    return 0;
+  }
+  uint32_t elapsed = now - last_failure_;
+  return elapsed >= backoff_ms_ ? 0 : backoff_ms_ - elapsed;
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
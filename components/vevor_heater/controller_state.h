@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace esphome {
+namespace vevor_heater {
+
+// What the controller wants from the heater, independent of what the heater reports
+enum class ControllerState : uint8_t {
+  IDLE = 0,      // Heater off and nothing requested
+  STARTING = 1,  // Start requested, waiting for stable combustion
+  RUNNING = 2,   // Heater in stable combustion
+  STOPPING = 3,  // Stop requested, waiting for the heater to report OFF
+  LOCKOUT = 4,   // Starts refused until the lockout clears (low voltage, restart limit)
+  FAULT = 5,     // Heater stopped on its own, waits for a new request
+};
+static const uint8_t CONTROLLER_STATE_COUNT = 6;
+
+enum class ControllerEvent : uint8_t {
+  START_REQUEST = 0,    // User, schedule or antifreeze wants heat
+  STOP_REQUEST = 1,     // User, schedule, antifreeze or low fuel wants the heater off
+  HEATER_OFF = 2,       // Status frame reports OFF
+  HEATER_IGNITING = 3,  // Status frame reports polling/preheat or heating up
+  HEATER_RUNNING = 4,   // Status frame reports stable combustion
+  HEATER_COOLING = 5,   // Status frame reports stopping/cooling
+  LOW_VOLTAGE = 6,      // Supply below the start or operate threshold
+  VOLTAGE_OK = 7,       // Supply recovered above the start threshold
+  RESET = 8,            // Clear lockout or fault
+  RESTART_LIMIT = 9,    // Too many failed starts, latch lockout until reset
+};
+static const uint8_t CONTROLLER_EVENT_COUNT = 10;
+
+// Condition a transition needs before it is taken
+enum class ControllerGuard : uint8_t {
+  NONE = 0,
+  START_PERMITTED = 1,  // Owner supplied start check (voltage, fuel, sensors)
+  WAS_ACTIVE = 2,       // Heater was igniting or burning before this report
+  REJECT = 3,           // Event is refused in this state
+  NOT_LATCHED = 4,      // Lockout was not latched by the restart limit
+};
+
+struct ControllerTransition {
+  ControllerState next;
+  ControllerGuard guard{ControllerGuard::NONE};
+};
+
+// Request the controller frame carries, the heater profile supplies its bytes
+enum class ControllerRequest : uint8_t {
+  STATUS = 0,  // Status request only
+  START = 1,
+  RUN = 2,     // Keep running
+  STOP = 3,
+};
+
+// Table driven controller state machine. Every transition is a single lookup in
+// a state x event table, and the request is a lookup in a state x heater phase
+// table, so the wire protocol follows from the state alone. No logging and no
+// ESPHome dependency, the owner logs from the transition callback.
+class ControllerStateMachine {
+ public:
+  using TransitionCallback = std::function<void(ControllerState from, ControllerState to, ControllerEvent event)>;
+
+  // Returns false if the event was refused by a guard
+  bool dispatch(ControllerEvent event);
+
+  ControllerState state() const { return state_; }
+  ControllerRequest request() const;
+
+  // Start or keep the heater running
+  bool is_heat_requested() const { return state_ == ControllerState::STARTING || state_ == ControllerState::RUNNING; }
+  bool is_locked_out() const { return state_ == ControllerState::LOCKOUT; }
+  // Lockout that only RESET clears
+  bool is_latched() const { return latched_; }
+  // Last reported heater phase as a heater event
+  ControllerEvent heater_phase() const { return heater_phase_; }
+
+  // Boot time restore of a persisted state, the only way to set a state without the table
+  void restore(ControllerState state) { state_ = state; }
+
+  void set_start_guard(std::function<bool()> &&guard) { start_guard_ = std::move(guard); }
+  void set_transition_callback(TransitionCallback &&callback) { on_transition_ = std::move(callback); }
+
+  static const char *state_to_string(ControllerState state);
+  static const char *event_to_string(ControllerEvent event);
+
+ protected:
+  static bool is_heater_event(ControllerEvent event) {
+    return event >= ControllerEvent::HEATER_OFF && event <= ControllerEvent::HEATER_COOLING;
+  }
+  bool check_guard(ControllerGuard guard) const;
+
+  ControllerState state_{ControllerState::IDLE};
+  ControllerEvent heater_phase_{ControllerEvent::HEATER_OFF};
+  bool latched_{false};
+  std::function<bool()> start_guard_;
+  TransitionCallback on_transition_;
+};
+
+// Exponential restart backoff after failed starts, latching after max_failures in a row.
+// Times are millis() values; the owner decides what counts as a failure or a success.
+class RestartPolicy {
+ public:
+  void set_max_failures(uint8_t max_failures) { max_failures_ = max_failures; }
+  void set_base_backoff(uint32_t backoff_ms) { base_backoff_ms_ = backoff_ms; }
+  void set_max_backoff(uint32_t backoff_ms) { max_backoff_ms_ = backoff_ms; }
+
+  // Returns true when this failure reaches the limit
+  bool record_failure(uint32_t now);
+  void record_success() { failures_ = 0; }
+  void reset() { failures_ = 0; }
+  // Failures and the backoff that was left when they were saved, counted from now
+  void restore(uint8_t failures, uint32_t backoff_remaining_ms, uint32_t now);
+
+  uint8_t failures() const { return failures_; }
+  uint8_t max_failures() const { return max_failures_; }
+  bool is_limit_reached() const { return failures_ >= max_failures_; }
+  uint32_t backoff_remaining(uint32_t now) const;
+
+ protected:
+  uint8_t max_failures_{3};
+  uint32_t base_backoff_ms_{60000};
+  uint32_t max_backoff_ms_{1800000};
+  uint8_t failures_{0};
+  uint32_t last_failure_{0};
+  uint32_t backoff_ms_{0};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
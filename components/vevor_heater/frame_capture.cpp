@@ -0,0 +1,155 @@
+#include "frame_capture.h"
+#include "esphome/core/log.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace esphome {
+namespace vevor_heater {
+
+static const char *const CAPTURE_FIELD_NAMES[CAPTURE_FIELD_COUNT] = {"state", "power", "voltage"};
+
+void FrameCapture::enable(size_t capacity) {
+  disable();
+  capacity_ = capacity;
+  frames_.reserve(capacity * CAPTURE_FRAME_SIZE);
+
+  // Power of two table at least twice the capacity keeps probe chains short
+  size_t table_size = 1;
+  while (table_size < capacity * 2) {
+    table_size <<= 1;
+  }
+  table_.assign(table_size, 0);
+}
+
+void FrameCapture::disable() {
+  frames_.clear();
+  frames_.shrink_to_fit();
+  table_.clear();
+  table_.shrink_to_fit();
+  capacity_ = 0;
+  count_ = 0;
+  total_frames_ = 0;
+  std::memset(mean_byte_, 0, sizeof(mean_byte_));
+  std::memset(m2_byte_, 0, sizeof(m2_byte_));
+  std::memset(mean_field_, 0, sizeof(mean_field_));
+  std::memset(m2_field_, 0, sizeof(m2_field_));
+  std::memset(comoment_, 0, sizeof(comoment_));
+}
+
+uint32_t FrameCapture::hash_frame(const uint8_t *frame) {
+  // FNV-1a
+  uint32_t hash = 2166136261UL;
+  for (size_t i = 0; i < CAPTURE_FRAME_SIZE; i++) {
+    hash ^= frame[i];
+    hash *= 16777619UL;
+  }
+  return hash;
+}
+
+bool FrameCapture::add(const uint8_t *frame, float state, float power, float voltage) {
+  if (!is_enabled()) {
+    return false;
+  }
+  total_frames_++;
+
+  size_t mask = table_.size() - 1;
+  size_t slot = hash_frame(frame) & mask;
+  while (table_[slot] != 0) {
+    if (std::memcmp(this->frame(table_[slot] - 1), frame, CAPTURE_FRAME_SIZE) == 0) {
+      return false;  // Already captured
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  if (count_ >= capacity_) {
+    // Full - statistics stay over the stored set so they remain consistent with the dump
+    return false;
+  }
+
+  frames_.insert(frames_.end(), frame, frame + CAPTURE_FRAME_SIZE);
+  table_[slot] = static_cast<uint16_t>(++count_);
+
+  const float fields[CAPTURE_FIELD_COUNT] = {state, power, voltage};
+  update_statistics(frame, fields);
+  return true;
+}
+
+void FrameCapture::update_statistics(const uint8_t *frame, const float *fields) {
+  float n = static_cast<float>(count_);
+
+  float field_delta[CAPTURE_FIELD_COUNT];
+  float field_delta_new[CAPTURE_FIELD_COUNT];
+  for (uint8_t f = 0; f < CAPTURE_FIELD_COUNT; f++) {
+    field_delta[f] = fields[f] - mean_field_[f];
+    mean_field_[f] += field_delta[f] / n;
+    field_delta_new[f] = fields[f] - mean_field_[f];
+    m2_field_[f] += field_delta[f] * field_delta_new[f];
+  }
+
+  for (size_t i = 0; i < CAPTURE_FRAME_SIZE; i++) {
+    float delta = frame[i] - mean_byte_[i];
+    mean_byte_[i] += delta / n;
+    m2_byte_[i] += delta * (frame[i] - mean_byte_[i]);
+    for (uint8_t f = 0; f < CAPTURE_FIELD_COUNT; f++) {
+      comoment_[i][f] += delta * field_delta_new[f];
+    }
+  }
+}
+
+float FrameCapture::entropy(size_t offset) const {
+  if (count_ == 0 || offset >= CAPTURE_FRAME_SIZE) {
+    return 0.0f;
+  }
+  uint16_t histogram[256] = {};
+  for (size_t i = 0; i < count_; i++) {
+    histogram[frame(i)[offset]]++;
+  }
+  float result = 0.0f;
+  for (uint16_t bucket : histogram) {
+    if (bucket > 0) {
+      float p = static_cast<float>(bucket) / count_;
+      result -= p * std::log2(p);
+    }
+  }
+  return result;
+}
+
+float FrameCapture::correlation(size_t offset, CaptureField field) const {
+  uint8_t f = static_cast<uint8_t>(field);
+  if (offset >= CAPTURE_FRAME_SIZE || m2_byte_[offset] <= 0.0f || m2_field_[f] <= 0.0f) {
+    return NAN;
+  }
+  return comoment_[offset][f] / std::sqrt(m2_byte_[offset] * m2_field_[f]);
+}
+
+void FrameCapture::dump(const char *tag) const {
+  ESP_LOGI(tag, "Frame capture: %u distinct of %u frames (capacity %u)", (unsigned) count_,
+           (unsigned) total_frames_, (unsigned) capacity_);
+
+  // One frame per line in a fixed format the host analyzer parses
+  char line[CAPTURE_FRAME_SIZE * 3 + 1];
+  for (size_t i = 0; i < count_; i++) {
+    const uint8_t *data = frame(i);
+    for (size_t b = 0; b < CAPTURE_FRAME_SIZE; b++) {
+      snprintf(&line[b * 3], 4, "%02X ", data[b]);
+    }
+    line[CAPTURE_FRAME_SIZE * 3 - 1] = '\0';
+    ESP_LOGI(tag, "CAPTURE %s", line);
+  }
+
+  // Byte statistics, skipping constant offsets
+  for (size_t offset = 0; offset < CAPTURE_FRAME_SIZE; offset++) {
+    float bits = entropy(offset);
+    if (bits <= 0.0f) {
+      continue;
+    }
+    ESP_LOGI(tag, "  byte %2u: entropy %.2f bits, r(%s)=%+.2f r(%s)=%+.2f r(%s)=%+.2f", (unsigned) offset, bits,
+             CAPTURE_FIELD_NAMES[0], correlation(offset, CaptureField::STATE), CAPTURE_FIELD_NAMES[1],
+             correlation(offset, CaptureField::POWER), CAPTURE_FIELD_NAMES[2],
+             correlation(offset, CaptureField::VOLTAGE));
+  }
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "heater_profile.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace vevor_heater {
+
+static const size_t CAPTURE_FRAME_SIZE = HEATER_PROFILE.heater_frame_length + 5;  // Heater status frame
+static const size_t DEFAULT_CAPTURE_CAPACITY = 64;
+
+// Known fields the undecoded bytes are correlated against
+enum class CaptureField : uint8_t {
+  STATE = 0,
+  POWER = 1,
+  VOLTAGE = 2,
+};
+static const uint8_t CAPTURE_FIELD_COUNT = 3;
+
+// Stores distinct status frames in a fixed-size dedup hash set and keeps running
+// per-byte statistics, so unknown protocol fields can be found from field data.
+// Memory is only allocated while capture is enabled.
+class FrameCapture {
+ public:
+  void enable(size_t capacity);
+  void disable();
+  bool is_enabled() const { return capacity_ > 0; }
+
+  // Returns true if the frame was new and stored
+  bool add(const uint8_t *frame, float state, float power, float voltage);
+
+  size_t size() const { return count_; }
+  size_t capacity() const { return capacity_; }
+  uint32_t total_frames() const { return total_frames_; }
+  const uint8_t *frame(size_t index) const { return &frames_[index * CAPTURE_FRAME_SIZE]; }
+
+  // Shannon entropy (bits) of a byte offset over the distinct frames
+  float entropy(size_t offset) const;
+  // Pearson correlation of a byte offset with a known field, NAN if either is constant
+  float correlation(size_t offset, CaptureField field) const;
+
+  void dump(const char *tag) const;
+
+ protected:
+  static uint32_t hash_frame(const uint8_t *frame);
+  void update_statistics(const uint8_t *frame, const float *fields);
+
+  std::vector<uint8_t> frames_;   // count_ frames of CAPTURE_FRAME_SIZE bytes
+  std::vector<uint16_t> table_;   // Open addressing, frame index + 1, 0 = empty
+  size_t capacity_{0};
+  size_t count_{0};
+  uint32_t total_frames_{0};
+
+  // Welford running moments over distinct frames
+  float mean_byte_[CAPTURE_FRAME_SIZE]{};
+  float m2_byte_[CAPTURE_FRAME_SIZE]{};
+  float mean_field_[CAPTURE_FIELD_COUNT]{};
+  float m2_field_[CAPTURE_FIELD_COUNT]{};
+  float comoment_[CAPTURE_FRAME_SIZE][CAPTURE_FIELD_COUNT]{};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,127 @@
+#include "frame_receiver.h"
+#include <algorithm>
+
+namespace esphome {
+namespace vevor_heater {
+
+// Whole frame size for a length byte, 0 for lengths no device sends
+static uint8_t frame_size_for_length(uint8_t length) {
+  switch (length) {
+    case HEATER_FRAME_LENGTH: return HEATER_FRAME_SIZE;
+    case CONTROLLER_FRAME_LENGTH: return CONTROLLER_FRAME_SIZE;
+    default: return 0;
+  }
+}
+
+// Checksum of the frame from start to the end of the buffer
+static bool checksum_matches(const std::vector<uint8_t> &buffer, size_t start) {
+  uint8_t sum = 0;
+  for (size_t i = start + 2; i + 1 < buffer.size(); i++) {
+    sum += buffer[i];
+  }
+  return sum == buffer.back();
+}
+
+uint8_t calculate_checksum(const std::vector<uint8_t> &frame) {
+  if (frame.size() < 4) {
+    return 0;
+  }
+  uint32_t sum = 0;
+  for (size_t i = 2; i < frame.size() - 1; ++i) {
+    sum += frame[i];
+  }
+  return static_cast<uint8_t>(sum % 256);
+}
+
+FrameError validate_frame(const std::vector<uint8_t> &frame) {
+  if (frame.empty() || frame[0] != FRAME_START) {
+    return FrameError::START;
+  }
+  // Length byte plus start, ID, command, length and checksum
+  if (frame.size() < 4 || frame.size() != static_cast<size_t>(frame[3]) + 5) {
+    return FrameError::LENGTH;
+  }
+  if (calculate_checksum(frame) != frame.back()) {
+    return FrameError::CHECKSUM;
+  }
+  return FrameError::NONE;
+}
+
+const char *frame_error_to_string(FrameError error) {
+  switch (error) {
+    case FrameError::NONE: return "OK";
+    case FrameError::START: return "Bad start byte";
+    case FrameError::LENGTH: return "Length mismatch";
+    case FrameError::CHECKSUM: return "Checksum mismatch";
+    default: return "Unknown";
+  }
+}
+
+FrameReceiver::FrameReceiver() { buffer_.reserve(HEATER_FRAME_SIZE); }
+
+bool FrameReceiver::feed(uint8_t byte, uint32_t now) {
+  // Bytes outside a frame are dropped until the next start byte
+  if (buffer_.empty() && byte != FRAME_START) {
+    return false;
+  }
+  buffer_.push_back(byte);
+  last_byte_time_ = now;
+  return check_frame();
+}
+
+bool FrameReceiver::check_frame() {
+  // Every byte is checked as it arrives, so a candidate is judged the moment it completes
+  while (buffer_.size() >= 4) {
+    uint8_t expected_size = frame_size_for_length(buffer_[3]);
+    // Unknown length, or a short frame found after a resync that already failed its checksum
+    if (expected_size == 0 || buffer_.size() > expected_size) {
+      resync();
+      continue;
+    }
+    if (buffer_.size() < expected_size) {
+      // A controller frame can complete inside a longer candidate started by noise
+      size_t start = buffer_.size() - CONTROLLER_FRAME_SIZE;
+      if (buffer_.size() > CONTROLLER_FRAME_SIZE && buffer_[start] == FRAME_START &&
+          buffer_[start + 3] == CONTROLLER_FRAME_LENGTH && checksum_matches(buffer_, start)) {
+        buffer_.erase(buffer_.begin(), buffer_.begin() + start);
+        resyncs_++;
+        return true;
+      }
+      return false;
+    }
+    // A bad checksum completes the frame for validate_frame() to reject, unless a
+    // later start byte suggests the real frame began inside this one
+    if (checksum_matches(buffer_, 0) || !has_later_start()) {
+      return true;
+    }
+    resync();
+  }
+  return false;
+}
+
+bool FrameReceiver::has_later_start() const {
+  for (size_t i = 1; i < buffer_.size(); i++) {
+    if (buffer_[i] == FRAME_START && (i + 3 >= buffer_.size() || frame_size_for_length(buffer_[i + 3]) != 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FrameReceiver::resync() {
+  // Restart at the next start byte after the current one, or drop everything
+  auto next = std::find(buffer_.begin() + 1, buffer_.end(), FRAME_START);
+  buffer_.erase(buffer_.begin(), next);
+  resyncs_++;
+}
+
+bool FrameReceiver::check_timeout(uint32_t now) {
+  if (!buffer_.empty() && (now - last_byte_time_) > FRAME_BYTE_TIMEOUT_MS) {
+    reset();
+    return true;
+  }
+  return false;
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
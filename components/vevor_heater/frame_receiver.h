@@ -0,0 +1,78 @@
+#pragma once
+
+#include "heater_profile.h"
+#include <cstdint>
+#include <vector>
+
+namespace esphome {
+namespace vevor_heater {
+
+// Communication constants, from the selected heater profile
+static const uint8_t FRAME_START = HEATER_PROFILE.frame_start;
+static const uint8_t CONTROLLER_ID = HEATER_PROFILE.controller_id;
+static const uint8_t HEATER_ID = HEATER_PROFILE.heater_id;
+static const uint8_t CONTROLLER_FRAME_LENGTH = HEATER_PROFILE.controller_frame_length;
+static const uint8_t HEATER_FRAME_LENGTH = HEATER_PROFILE.heater_frame_length;
+// Whole frame: start, ID, command, length byte, payload and checksum
+static const uint8_t CONTROLLER_FRAME_SIZE = CONTROLLER_FRAME_LENGTH + 5;  // 16 for Vevor
+static const uint8_t HEATER_FRAME_SIZE = HEATER_FRAME_LENGTH + 5;          // 56 for Vevor
+static const uint32_t FRAME_BYTE_TIMEOUT_MS = 100;                         // Gap that aborts a partial frame
+
+// Byte 1 of an addressed request to the heater with this device ID: the controller ID
+// offset like the device ID is from the heater ID (0x78 -> 0x67). Not confirmed on
+// hardware, so it is only sent with the experimental addressed_requests option; plain
+// requests always carry the controller ID.
+constexpr uint8_t request_address(uint8_t device_id) {
+  return static_cast<uint8_t>(CONTROLLER_ID + (device_id - HEATER_ID));
+}
+// Requests, including our own read back on a half-duplex line, by their length byte
+inline bool is_controller_frame(const std::vector<uint8_t> &frame) {
+  return frame.size() > 3 && frame[3] == CONTROLLER_FRAME_LENGTH;
+}
+
+enum class FrameError : uint8_t {
+  NONE = 0,
+  START = 1,     // First byte is not the start byte
+  LENGTH = 2,    // Size differs from the one the length byte implies
+  CHECKSUM = 3,
+};
+
+// Sum of bytes 2 to the second to last, modulo 256
+uint8_t calculate_checksum(const std::vector<uint8_t> &frame);
+// Checks start byte, the size the length byte implies and the checksum
+FrameError validate_frame(const std::vector<uint8_t> &frame);
+const char *frame_error_to_string(FrameError error);
+
+// Assembles frames from the byte stream: start byte, length byte at offset 3,
+// heater status frames are 56 bytes and controller frames 16. A start byte that
+// turns out to be noise (unknown length, or a bad checksum while another start
+// byte follows) is skipped by rescanning the buffered bytes, so a frame right
+// after line noise is not lost. The buffer never grows beyond one heater frame.
+// A frame with a bad checksum and no later start byte still completes, so the
+// owner can log, count or reject it through validate_frame().
+class FrameReceiver {
+ public:
+  FrameReceiver();
+  // Returns true when frame() holds a complete frame; call reset() after handling it
+  bool feed(uint8_t byte, uint32_t now);
+  // Drops a partial frame after a gap in the byte stream, true if one was dropped
+  bool check_timeout(uint32_t now);
+  void reset() { buffer_.clear(); }
+
+  const std::vector<uint8_t> &frame() const { return buffer_; }
+  bool in_frame() const { return !buffer_.empty(); }
+  uint32_t last_byte_time() const { return last_byte_time_; }
+  uint32_t resyncs() const { return resyncs_; }
+
+ protected:
+  bool check_frame();
+  bool has_later_start() const;
+  void resync();
+
+  std::vector<uint8_t> buffer_;
+  uint32_t last_byte_time_{0};
+  uint32_t resyncs_{0};  // Start bytes dropped as noise
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "esphome/core/defines.h"
+#include "controller_state.h"
+#include <cstdint>
+
+namespace esphome {
+namespace vevor_heater {
+
+// Status frame bytes kept with each fault for reverse engineering
+static const uint8_t PROFILE_UNDECODED_BYTES = 8;
+
+// Byte offsets of the decoded status frame fields, 16 bit fields are big-endian
+struct StatusLayout {
+  uint8_t state;
+  uint8_t power_level;
+  uint8_t input_voltage;      // 0.1 V
+  uint8_t glow_plug_current;  // A
+  uint8_t cooling_flag;
+  uint8_t heat_exchanger;     // int16, 0.1 °C
+  uint8_t state_duration;     // uint16, s
+  uint8_t pump_frequency;     // 0.1 Hz
+  uint8_t fan_speed;          // uint16, rpm
+  uint8_t undecoded[PROFILE_UNDECODED_BYTES];  // Offsets nothing decodes yet
+};
+
+// On-wire controller frame command and requested state bytes (Vevor: bytes 2 and 9)
+struct ControllerCommand {
+  uint8_t command;
+  uint8_t requested_state;
+};
+
+// Byte offsets of the controller request fields
+struct RequestLayout {
+  uint8_t command;
+  uint8_t power_level;
+  uint8_t requested_state;
+};
+
+// Everything that differs between heater models: framing, field offsets, command
+// encoding, power range, pump calibration and the default safety limits. Only the
+// profile selected in YAML is compiled in, as constexpr data, so every lookup folds
+// to the same constant the hand-written code used.
+struct HeaterProfile {
+  const char *name;
+  // Framing
+  uint8_t frame_start;
+  uint8_t controller_id;
+  uint8_t heater_id;
+  uint8_t controller_frame_length;  // Length byte, the frame adds start, ID, command, length and checksum
+  uint8_t heater_frame_length;
+  StatusLayout status;
+  RequestLayout request;
+  // Command encoding (command byte, requested state byte)
+  ControllerCommand command_status;
+  ControllerCommand command_start;
+  ControllerCommand command_run;
+  ControllerCommand command_stop;
+  // On-wire power byte for levels 1 and 10, the steps between are spread evenly
+  uint8_t min_power;
+  uint8_t max_power;
+  // Pump calibration before any refill has been learned
+  float injected_per_pulse;  // ml per pulse
+  // Safety defaults, YAML options override them
+  float min_voltage_start;
+  float min_voltage_operate;
+  float overheat_temperature;
+};
+
+// One block per model, picked by the VEVOR_HEATER_MODEL_* define the YAML model option
+// sets. A new model adds a block here and an entry in HEATER_MODELS in __init__.py.
+#if defined(VEVOR_HEATER_MODEL_VEVOR)
+// Vevor diesel air heater, 12 V, 0xAA framed protocol at 4800 baud
+static constexpr HeaterProfile HEATER_PROFILE{
+    "Vevor",
+    0xAA, 0x66, 0x77, 0x0B, 0x33,
+    {5, 6, 11, 13, 14, 16, 20, 23, 28, {2, 4, 7, 8, 9, 10, 12, 15}},
+    {2, 8, 9},
+    {0x02, 0x02},  // Status request
+    {0x06, 0x06},  // Start
+    {0x02, 0x08},  // Keep running
+    {0x06, 0x05},  // Stop
+    1, 10,
+    0.022f,
+    12.3f, 11.4f, 250.0f,
+};
+#else
+#error "No heater model selected, set the vevor_heater model option"
+#endif
+
+// Power level 1-10 to the on-wire power byte and back, identities for a 1-10 profile
+constexpr uint8_t encode_power_level(uint8_t level) {
+  return HEATER_PROFILE.min_power + (level - 1) * (HEATER_PROFILE.max_power - HEATER_PROFILE.min_power) / 9;
+}
+constexpr bool is_valid_power_byte(uint8_t raw) {
+  return raw >= HEATER_PROFILE.min_power && raw <= HEATER_PROFILE.max_power;
+}
+constexpr uint8_t decode_power_level(uint8_t raw) {
+  return 1 + ((raw - HEATER_PROFILE.min_power) * 9 + (HEATER_PROFILE.max_power - HEATER_PROFILE.min_power) / 2) /
+                 (HEATER_PROFILE.max_power - HEATER_PROFILE.min_power);
+}
+
+// Controller request to the profile's command and requested state bytes
+constexpr ControllerCommand encode_request(ControllerRequest request) {
+  return request == ControllerRequest::START  ? HEATER_PROFILE.command_start
+         : request == ControllerRequest::RUN  ? HEATER_PROFILE.command_run
+         : request == ControllerRequest::STOP ? HEATER_PROFILE.command_stop
+                                              : HEATER_PROFILE.command_status;
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
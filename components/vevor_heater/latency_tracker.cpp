@@ -0,0 +1,119 @@
+#include "latency_tracker.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace vevor_heater {
+
+void LatencyHistogram::add(uint32_t ms) {
+  uint8_t bucket = 0;
+  while (bucket < LATENCY_BUCKETS - 1 && ms > LATENCY_BUCKET_EDGES_MS[bucket]) {
+    bucket++;
+  }
+  counts_[bucket]++;
+  count_++;
+  if (ms > max_) {
+    max_ = ms;
+  }
+}
+
+uint32_t LatencyHistogram::percentile(uint8_t percent) const {
+  if (count_ == 0) {
+    return 0;
+  }
+  // Rank of the sample, rounded up so p95 of 10 samples is the 10th
+  uint32_t rank = (static_cast<uint64_t>(count_) * percent + 99) / 100;
+  uint32_t seen = 0;
+  for (uint8_t bucket = 0; bucket < LATENCY_BUCKETS - 1; bucket++) {
+    seen += counts_[bucket];
+    if (seen >= rank) {
+      return LATENCY_BUCKET_EDGES_MS[bucket] < max_ ? LATENCY_BUCKET_EDGES_MS[bucket] : max_;
+    }
+  }
+  return max_;
+}
+
+uint32_t LatencyHistogram::get(LatencyStat stat) const {
+  switch (stat) {
+    case LatencyStat::P50: return percentile(50);
+    case LatencyStat::P95: return percentile(95);
+    default: return max_;
+  }
+}
+
+void LatencyTracker::mark_intent(uint32_t now) {
+  // A new command replaces one still in flight, only the latest can be confirmed
+  phase_ = Phase::REQUESTED;
+  intent_time_ = now;
+}
+
+void LatencyTracker::mark_built(uint32_t now) {
+  if (phase_ == Phase::REQUESTED) {
+    phase_ = Phase::BUILT;
+    built_time_ = now;
+  }
+}
+
+void LatencyTracker::mark_sent(uint32_t now) {
+  // The UART task reports its send with every frame it answers, count it once
+  if (sent_seen_ && now == sent_time_) {
+    return;
+  }
+  sent_seen_ = true;
+  sent_time_ = now;
+  awaiting_response_ = true;
+  if (phase_ == Phase::BUILT && static_cast<int32_t>(now - built_time_) >= 0) {
+    histogram_for(LatencyMetric::INTENT_TO_WIRE).add(now - intent_time_);
+    phase_ = Phase::SENT;
+  }
+}
+
+void LatencyTracker::mark_response(uint32_t now) {
+  if (!awaiting_response_) {
+    return;  // Unsolicited or a second frame for the same request
+  }
+  awaiting_response_ = false;
+  histogram_for(LatencyMetric::ROUND_TRIP).add(now - sent_time_);
+}
+
+void LatencyTracker::mark_confirmed(uint32_t now) {
+  // Only a report that follows our request confirms it
+  if (phase_ != Phase::SENT) {
+    return;
+  }
+  histogram_for(LatencyMetric::INTENT_TO_CONFIRMED).add(now - intent_time_);
+  phase_ = Phase::NONE;
+}
+
+void LatencyTracker::check_timeout(uint32_t now) {
+  if (phase_ != Phase::NONE && now - intent_time_ >= LATENCY_CONFIRM_TIMEOUT_MS) {
+    phase_ = Phase::NONE;
+    unconfirmed_++;
+  }
+}
+
+const char *LatencyTracker::metric_to_string(LatencyMetric metric) {
+  switch (metric) {
+    case LatencyMetric::ROUND_TRIP: return "Round Trip";
+    case LatencyMetric::INTENT_TO_WIRE: return "Intent To Wire";
+    case LatencyMetric::INTENT_TO_CONFIRMED: return "Intent To Confirmed";
+    default: return "Unknown";
+  }
+}
+
+void LatencyTracker::dump_config(const char *tag) const {
+  for (uint8_t i = 0; i < LATENCY_METRIC_COUNT; i++) {
+    const LatencyHistogram &h = histograms_[i];
+    if (h.count() == 0) {
+      continue;
+    }
+    ESP_LOGCONFIG(tag, "  %s: p50 %u ms, p95 %u ms, max %u ms (%u samples)",
+                  metric_to_string(static_cast<LatencyMetric>(i)), (unsigned) h.percentile(50),
+                  (unsigned) h.percentile(95), (unsigned) h.max(), (unsigned) h.count());
+  }
+  if (unconfirmed_ > 0) {
+    ESP_LOGCONFIG(tag, "  Unconfirmed Commands: %u", (unsigned) unconfirmed_);
+  }
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
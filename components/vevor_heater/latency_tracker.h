@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+namespace esphome {
+namespace vevor_heater {
+
+// Upper bucket edges in ms, one more bucket catches everything above the last edge.
+// tools/bus_simulator.py uses the same edges so simulated and measured percentiles compare.
+static const uint8_t LATENCY_BUCKETS = 17;
+static const uint32_t LATENCY_BUCKET_EDGES_MS[LATENCY_BUCKETS - 1] = {
+    10, 20, 50, 100, 150, 200, 300, 500, 750, 1000, 1500, 2000, 3000, 5000, 10000, 30000,
+};
+static const uint32_t LATENCY_CONFIRM_TIMEOUT_MS = 120000;  // Intent dropped as unconfirmed after this
+
+enum class LatencyMetric : uint8_t {
+  ROUND_TRIP = 0,           // Request sent to heater status frame received
+  INTENT_TO_WIRE = 1,       // Start or stop requested to the first request carrying it
+  INTENT_TO_CONFIRMED = 2,  // Start or stop requested to the heater reporting the new state
+};
+static const uint8_t LATENCY_METRIC_COUNT = 3;
+
+enum class LatencyStat : uint8_t {
+  P50 = 0,
+  P95 = 1,
+  MAX = 2,
+};
+static const uint8_t LATENCY_STAT_COUNT = 3;
+
+// Fixed-bucket histogram, constant memory and time per sample. Percentiles are the
+// upper edge of the bucket they fall in, capped at the largest sample, so they never
+// understate a latency budget.
+class LatencyHistogram {
+ public:
+  void add(uint32_t ms);
+  // 0 while empty
+  uint32_t percentile(uint8_t percent) const;
+  uint32_t get(LatencyStat stat) const;
+  uint32_t max() const { return max_; }
+  uint32_t count() const { return count_; }
+
+ protected:
+  uint32_t counts_[LATENCY_BUCKETS]{};
+  uint32_t count_{0};
+  uint32_t max_{0};
+};
+
+// Follows one start or stop command from the request through the first controller
+// frame built and sent after it to the heater reporting the new state, and times every
+// request against the status frame that answers it. Built and sent are separate because
+// the UART task sends a frame some time after the main loop builds it.
+class LatencyTracker {
+ public:
+  void mark_intent(uint32_t now);
+  // A controller frame was built from the current state, the next send carries it
+  void mark_built(uint32_t now);
+  void mark_sent(uint32_t now);
+  // Heater status frame completed
+  void mark_response(uint32_t now);
+  void mark_confirmed(uint32_t now);
+  void check_timeout(uint32_t now);
+
+  bool intent_pending() const { return phase_ != Phase::NONE; }
+  const LatencyHistogram &histogram(LatencyMetric metric) const { return histograms_[static_cast<uint8_t>(metric)]; }
+  uint32_t unconfirmed() const { return unconfirmed_; }
+  void dump_config(const char *tag) const;
+
+  static const char *metric_to_string(LatencyMetric metric);
+
+ protected:
+  enum class Phase : uint8_t { NONE, REQUESTED, BUILT, SENT };
+
+  LatencyHistogram &histogram_for(LatencyMetric metric) { return histograms_[static_cast<uint8_t>(metric)]; }
+
+  LatencyHistogram histograms_[LATENCY_METRIC_COUNT];
+  Phase phase_{Phase::NONE};
+  uint32_t intent_time_{0};
+  uint32_t built_time_{0};
+  uint32_t sent_time_{0};
+  bool sent_seen_{false};
+  bool awaiting_response_{false};
+  uint32_t unconfirmed_{0};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
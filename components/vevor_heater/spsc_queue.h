@@ -0,0 +1,96 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace esphome {
+namespace vevor_heater {
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+// Indices run freely and are masked on access, so all N slots are usable.
+template<typename T, size_t N> class SpscQueue {
+  static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscQueue size must be a power of two");
+  static_assert(std::is_trivially_copyable<T>::value, "SpscQueue holds plain data");
+
+ public:
+  // Producer side, false when the queue is full
+  bool push(const T &item) {
+    uint32_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_.load(std::memory_order_acquire) >= N) {
+      return false;
+    }
+    slots_[head & (N - 1)] = item;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side, false when the queue is empty
+  bool pop(T *item) {
+    uint32_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_.load(std::memory_order_acquire) == tail) {
+      return false;
+    }
+    *item = slots_[tail & (N - 1)];
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t size() const { return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire); }
+  bool empty() const { return size() == 0; }
+
+ protected:
+  T slots_[N];
+  std::atomic<uint32_t> head_{0};  // Written by the producer only
+  std::atomic<uint32_t> tail_{0};  // Written by the consumer only
+};
+
+// Latest-value cell for one writer and any number of readers. A read never waits: it
+// fails while a write is in progress and the reader tries again later, so a reader
+// with a higher priority than the writer on the same core cannot starve it. The value
+// is copied through relaxed atomic words, so a torn copy is discarded instead of being
+// undefined.
+template<typename T> class Seqlock {
+  static_assert(std::is_trivially_copyable<T>::value, "Seqlock holds plain data");
+  static const size_t WORDS = (sizeof(T) + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+
+ public:
+  void write(const T &value) {
+    uint32_t words[WORDS] = {};
+    std::memcpy(words, &value, sizeof(T));
+    uint32_t seq = sequence_.load(std::memory_order_relaxed);
+    sequence_.store(seq + 1, std::memory_order_relaxed);  // Odd: write in progress
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < WORDS; i++) {
+      data_[i].store(words[i], std::memory_order_relaxed);
+    }
+    sequence_.store(seq + 2, std::memory_order_release);
+  }
+
+  // One attempt, false before the first write or when it overlapped a write
+  bool read(T *value) const {
+    uint32_t words[WORDS];
+    uint32_t before = sequence_.load(std::memory_order_acquire);
+    if (before == 0 || (before & 1) != 0) {
+      return false;
+    }
+    for (size_t i = 0; i < WORDS; i++) {
+      words[i] = data_[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (sequence_.load(std::memory_order_relaxed) != before) {
+      return false;
+    }
+    std::memcpy(value, words, sizeof(T));
+    return true;
+  }
+
+ protected:
+  std::atomic<uint32_t> data_[WORDS] = {};
+  std::atomic<uint32_t> sequence_{0};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,148 @@
+#include "status_snapshot.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace esphome {
+namespace vevor_heater {
+
+static void put_u16(uint8_t *out, uint16_t value) {
+  out[0] = value & 0xFF;
+  out[1] = value >> 8;
+}
+
+static void put_u32(uint8_t *out, uint32_t value) {
+  put_u16(out, value & 0xFFFF);
+  put_u16(out + 2, value >> 16);
+}
+
+// Fixed point with INT16_MIN for unknown
+static void put_scaled_i16(uint8_t *out, float value, float scale) {
+  int16_t raw = INT16_MIN;
+  if (!std::isnan(value)) {
+    float scaled = std::round(value * scale);
+    raw = static_cast<int16_t>(std::max(-32767.0f, std::min(32767.0f, scaled)));
+  }
+  put_u16(out, static_cast<uint16_t>(raw));
+}
+
+// Fixed point with 0xFFFF (or 0xFFFFFFFF) for unknown
+static void put_scaled_u16(uint8_t *out, float value, float scale) {
+  uint16_t raw = 0xFFFF;
+  if (!std::isnan(value)) {
+    raw = static_cast<uint16_t>(std::max(0.0f, std::min(65534.0f, std::round(value * scale))));
+  }
+  put_u16(out, raw);
+}
+
+static void put_scaled_u32(uint8_t *out, float value, float scale) {
+  uint32_t raw = 0xFFFFFFFF;
+  if (!std::isnan(value) && value >= 0.0f) {
+    raw = static_cast<uint32_t>(std::min(4294967294.0, std::round(static_cast<double>(value) * scale)));
+  }
+  put_u32(out, raw);
+}
+
+static void append_float(std::string &out, const char *key, float value, int decimals) {
+  char buffer[48];
+  if (std::isnan(value)) {
+    snprintf(buffer, sizeof(buffer), ",\"%s\":null", key);
+  } else {
+    snprintf(buffer, sizeof(buffer), ",\"%s\":%.*f", key, decimals, value);
+  }
+  out += buffer;
+}
+
+static void append_uint(std::string &out, const char *key, uint32_t value) {
+  char buffer[48];
+  snprintf(buffer, sizeof(buffer), ",\"%s\":%u", key, (unsigned) value);
+  out += buffer;
+}
+
+static void append_bool(std::string &out, const char *key, bool value) {
+  out += ",\"";
+  out += key;
+  out += value ? "\":true" : "\":false";
+}
+
+static void append_string(std::string &out, const char *key, const char *value) {
+  // Values are fixed state names, no escaping needed
+  out += ",\"";
+  out += key;
+  out += "\":\"";
+  out += value;
+  out += '"';
+}
+
+std::string StatusSnapshot::to_json() {
+  LockGuard guard(lock_);
+  uint32_t version = version_;
+  if (json_version_ == version) {
+    return json_;
+  }
+
+  json_.clear();
+  json_.reserve(512);
+  json_ += "{\"version\":";
+  json_ += std::to_string(version);
+  append_string(json_, "state", heater_state);
+  append_string(json_, "controller_state", controller_state);
+  append_bool(json_, "connected", connected);
+  append_bool(json_, "stale", stale);
+  append_uint(json_, "power_level", power_level);
+  append_uint(json_, "state_duration", state_duration);
+  append_bool(json_, "cooling_down", cooling_down);
+  append_float(json_, "input_voltage", input_voltage, 1);
+  append_float(json_, "glow_plug_current", glow_plug_current, 0);
+  append_float(json_, "heat_exchanger_temperature", heat_exchanger_temperature, 1);
+  append_float(json_, "external_temperature", external_temperature, 1);
+  append_float(json_, "pump_frequency", pump_frequency, 1);
+  append_uint(json_, "fan_speed", fan_speed);
+  append_float(json_, "consumption_rate", consumption_rate, 1);
+  append_float(json_, "daily_consumption", daily_consumption, 1);
+  append_float(json_, "total_consumption", total_consumption, 0);
+  append_float(json_, "tank_level", tank_level, 1);
+  append_bool(json_, "low_fuel", low_fuel);
+  append_uint(json_, "failed_starts", failed_starts);
+  append_bool(json_, "locked_out", locked_out);
+  append_uint(json_, "fault_count", fault_count);
+  append_string(json_, "last_fault", last_fault);
+  json_ += '}';
+
+  json_version_ = version;
+  return json_;
+}
+
+void StatusSnapshot::to_binary(uint8_t *out, uint32_t sequence) const {
+  uint8_t flags = 0;
+  flags |= connected ? 0x01 : 0;
+  flags |= cooling_down ? 0x02 : 0;
+  flags |= low_fuel ? 0x04 : 0;
+  flags |= locked_out ? 0x08 : 0;
+  flags |= stale ? 0x10 : 0;
+
+  out[0] = TELEMETRY_SCHEMA_VERSION;
+  out[1] = flags;
+  out[2] = heater_state_code;
+  out[3] = controller_state_code;
+  out[4] = power_level;
+  out[5] = failed_starts;
+  put_u16(out + 6, state_duration);
+  put_u16(out + 8, fan_speed);
+  put_scaled_i16(out + 10, input_voltage, 10.0f);
+  put_scaled_i16(out + 12, heat_exchanger_temperature, 10.0f);
+  put_scaled_i16(out + 14, external_temperature, 10.0f);
+  out[16] = std::isnan(glow_plug_current) ? 0xFF : static_cast<uint8_t>(std::min(254.0f, glow_plug_current));
+  out[17] = std::isnan(pump_frequency) ? 0xFF
+                                       : static_cast<uint8_t>(std::min(254.0f, std::round(pump_frequency * 10.0f)));
+  put_scaled_u16(out + 18, consumption_rate, 10.0f);
+  put_scaled_u32(out + 20, daily_consumption, 10.0f);
+  put_scaled_u32(out + 24, total_consumption, 1.0f);
+  put_scaled_u16(out + 28, tank_level, 100.0f);
+  put_u16(out + 30, fault_count);
+  out[32] = last_fault_code;
+  out[33] = 0;  // Reserved
+  put_u32(out + 34, sequence);
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
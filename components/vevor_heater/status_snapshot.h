@@ -0,0 +1,81 @@
+#pragma once
+
+#include "esphome/core/helpers.h"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace esphome {
+namespace vevor_heater {
+
+// Binary telemetry payload, all fields little-endian, decoded by tools/telemetry_decoder.py
+static const uint8_t TELEMETRY_SCHEMA_VERSION = 1;
+static const size_t TELEMETRY_PAYLOAD_SIZE = 38;
+
+// Compact copy of everything a monitoring client wants in one request. Fields are set
+// incrementally as frames and fuel updates arrive; the JSON body is only rebuilt when a
+// client asks after a field actually changed. Fields are written on the main loop and
+// the JSON is built on the web server task, so both go through the lock; main loop
+// readers (to_binary, direct field reads) need none.
+class StatusSnapshot {
+ public:
+  // State names are static strings, compared by pointer
+  const char *heater_state{"Unknown"};
+  const char *controller_state{"Idle"};
+  const char *last_fault{"None"};
+  uint8_t heater_state_code{0xFF};
+  uint8_t controller_state_code{0};
+  uint8_t last_fault_code{0};
+  uint8_t power_level{0};
+  uint16_t state_duration{0};
+  uint16_t fan_speed{0};
+  uint8_t failed_starts{0};
+  uint16_t fault_count{0};
+  bool connected{false};
+  bool cooling_down{false};
+  bool low_fuel{false};
+  bool locked_out{false};
+  bool stale{false};  // Values restored at boot, no heater frame yet
+  float input_voltage{NAN};
+  float glow_plug_current{NAN};
+  float heat_exchanger_temperature{NAN};
+  float external_temperature{NAN};
+  float pump_frequency{NAN};
+  float consumption_rate{NAN};   // ml/h
+  float daily_consumption{NAN};  // ml
+  float total_consumption{NAN};  // ml
+  float tank_level{NAN};         // %
+
+  template<typename T> void set(T &field, T value) {
+    if (field != value) {
+      LockGuard guard(lock_);
+      field = value;
+      version_++;
+    }
+  }
+  void set(float &field, float value) {
+    if (field == value || (std::isnan(field) && std::isnan(value))) {
+      return;
+    }
+    LockGuard guard(lock_);
+    field = value;
+    version_++;
+  }
+
+  uint32_t version() const { return version_; }
+  // Copy of the cached JSON body, rebuilt only if a field changed since the last call.
+  // Safe to call from any task.
+  std::string to_json();
+  // Fixed layout binary payload of TELEMETRY_PAYLOAD_SIZE bytes
+  void to_binary(uint8_t *out, uint32_t sequence) const;
+
+ protected:
+  uint32_t version_{1};
+  uint32_t json_version_{0};
+  std::string json_;
+  Mutex lock_;  // Fields and version against to_json()
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
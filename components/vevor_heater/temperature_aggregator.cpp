@@ -0,0 +1,133 @@
+#include "temperature_aggregator.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+
+namespace esphome {
+namespace vevor_heater {
+
+static const char *const AGGREGATOR_TAG = "vevor_heater";
+
+void TemperatureAggregator::add_input(sensor::Sensor *sensor, float weight, bool critical, uint32_t max_age_ms) {
+  size_t index = inputs_.size();
+  Input input;
+  input.sensor = sensor;
+  input.weight = weight;
+  input.critical = critical;
+  input.max_age_ms = max_age_ms;
+  inputs_.push_back(input);
+  sensor->add_on_state_callback([this, index](float value) { this->on_input(index, value); });
+}
+
+void TemperatureAggregator::on_input(size_t index, float value) {
+  Input &input = inputs_[index];
+  bool was_fresh = !std::isnan(input.value);
+  input.value = value;
+  input.last_update = millis();
+  if (!was_fresh && !std::isnan(value)) {
+    ESP_LOGI(AGGREGATOR_TAG, "Temperature input '%s' available (%.1f°C)", input.sensor->get_name().c_str(), value);
+  }
+  recalculate();
+}
+
+void TemperatureAggregator::check_stale(uint32_t now) {
+  bool changed = false;
+  for (Input &input : inputs_) {
+    if (input.max_age_ms == 0 || std::isnan(input.value) || now - input.last_update < input.max_age_ms) {
+      continue;
+    }
+    ESP_LOGW(AGGREGATOR_TAG, "Temperature input '%s' stale for %u s, dropped", input.sensor->get_name().c_str(),
+             (unsigned) ((now - input.last_update) / 1000));
+    input.value = NAN;
+    changed = true;
+  }
+  if (changed) {
+    recalculate();
+  }
+}
+
+void TemperatureAggregator::recalculate() {
+  float lowest = NAN;
+  float highest = NAN;
+  float lowest_critical = NAN;
+  float weighted_sum = 0.0f;
+  float weight_total = 0.0f;
+
+  for (const Input &input : inputs_) {
+    if (std::isnan(input.value)) {
+      continue;
+    }
+    if (std::isnan(lowest) || input.value < lowest) {
+      lowest = input.value;
+    }
+    if (std::isnan(highest) || input.value > highest) {
+      highest = input.value;
+    }
+    if (input.critical && (std::isnan(lowest_critical) || input.value < lowest_critical)) {
+      lowest_critical = input.value;
+    }
+    weighted_sum += input.value * input.weight;
+    weight_total += input.weight;
+  }
+  float mean = weight_total > 0.0f ? weighted_sum / weight_total : lowest;
+
+  float value;
+  switch (mode_) {
+    case AggregationMode::MIN:
+      value = lowest;
+      break;
+    case AggregationMode::MAX:
+      value = highest;
+      break;
+    case AggregationMode::LOWEST_CRITICAL:
+      value = std::isnan(lowest_critical) ? mean : lowest_critical;
+      break;
+    case AggregationMode::WEIGHTED_MEAN:
+    default:
+      value = mean;
+      break;
+  }
+
+  if (value == value_ || (std::isnan(value) && std::isnan(value_))) {
+    return;
+  }
+  if (std::isnan(value)) {
+    ESP_LOGW(AGGREGATOR_TAG, "All temperature inputs lost");
+  }
+  value_ = value;
+  if (on_change_) {
+    on_change_(value_);
+  }
+}
+
+size_t TemperatureAggregator::fresh_count() const {
+  size_t count = 0;
+  for (const Input &input : inputs_) {
+    if (!std::isnan(input.value)) {
+      count++;
+    }
+  }
+  return count;
+}
+
+const char *TemperatureAggregator::mode_to_string(AggregationMode mode) {
+  switch (mode) {
+    case AggregationMode::MIN: return "Min";
+    case AggregationMode::MAX: return "Max";
+    case AggregationMode::WEIGHTED_MEAN: return "Weighted Mean";
+    case AggregationMode::LOWEST_CRITICAL: return "Lowest Critical";
+    default: return "Unknown";
+  }
+}
+
+void TemperatureAggregator::dump_config(const char *tag) const {
+  ESP_LOGCONFIG(tag, "  Temperature Inputs: %u (%s), %u fresh", (unsigned) inputs_.size(), mode_to_string(mode_),
+                (unsigned) fresh_count());
+  for (const Input &input : inputs_) {
+    ESP_LOGCONFIG(tag, "    %s: weight %.2f%s, max age %u s, %s", input.sensor->get_name().c_str(), input.weight,
+                  input.critical ? ", critical" : "", (unsigned) (input.max_age_ms / 1000),
+                  std::isnan(input.value) ? "no data" : "fresh");
+  }
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
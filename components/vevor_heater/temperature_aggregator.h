@@ -0,0 +1,61 @@
+#pragma once
+
+#include "esphome/components/sensor/sensor.h"
+#include <cmath>
+#include <functional>
+#include <vector>
+
+namespace esphome {
+namespace vevor_heater {
+
+enum class AggregationMode : uint8_t {
+  MIN = 0,              // Coldest input
+  MAX = 1,              // Warmest input
+  WEIGHTED_MEAN = 2,    // Weight-averaged over the fresh inputs
+  LOWEST_CRITICAL = 3,  // Coldest critical input, weighted mean of the rest if no critical input is fresh
+};
+
+// Combines several temperature sensors into one control input. Every sensor publish
+// updates the result at once; inputs that stop publishing for longer than their max age
+// drop out, so control only degrades when every input is gone.
+class TemperatureAggregator {
+ public:
+  // max_age_ms 0 never expires the input
+  void add_input(sensor::Sensor *sensor, float weight, bool critical, uint32_t max_age_ms);
+  void set_mode(AggregationMode mode) { mode_ = mode; }
+  void set_on_change(std::function<void(float)> &&callback) { on_change_ = std::move(callback); }
+
+  // Drops inputs that went quiet, call periodically
+  void check_stale(uint32_t now);
+
+  float value() const { return value_; }
+  bool has_value() const { return !std::isnan(value_); }
+  bool has_inputs() const { return !inputs_.empty(); }
+  size_t input_count() const { return inputs_.size(); }
+  size_t fresh_count() const;
+  AggregationMode mode() const { return mode_; }
+
+  static const char *mode_to_string(AggregationMode mode);
+  void dump_config(const char *tag) const;
+
+ protected:
+  struct Input {
+    sensor::Sensor *sensor;
+    float weight;
+    bool critical;
+    uint32_t max_age_ms;
+    float value{NAN};
+    uint32_t last_update{0};
+  };
+
+  void on_input(size_t index, float value);
+  void recalculate();
+
+  std::vector<Input> inputs_;
+  AggregationMode mode_{AggregationMode::WEIGHTED_MEAN};
+  float value_{NAN};
+  std::function<void(float)> on_change_;
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,79 @@
+#include "uart_task.h"
+#include "esphome/core/hal.h"
+#include <algorithm>
+#include <cstring>
+
+#ifdef USE_ESP32
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#endif
+
+namespace esphome {
+namespace vevor_heater {
+
+bool UartTask::start(uint8_t core, uint8_t priority) {
+#ifdef USE_ESP32
+  TaskHandle_t handle;
+  return xTaskCreatePinnedToCore(&UartTask::task_main, "vevor_uart", UART_TASK_STACK_SIZE, this, priority, &handle,
+                                 core) == pdPASS;
+#else
+  return false;
+#endif
+}
+
+void UartTask::task_main(void *arg) {
+#ifdef USE_ESP32
+  UartTask *task = static_cast<UartTask *>(arg);
+  while (true) {
+    task->poll(millis());
+    vTaskDelay(pdMS_TO_TICKS(UART_TASK_POLL_MS));
+  }
+#endif
+}
+
+void UartTask::poll(uint32_t now) {
+  while (device_->available()) {
+    uint8_t byte;
+    device_->read_byte(&byte);
+    if (!receiver_.feed(byte, now)) {
+      continue;
+    }
+    const std::vector<uint8_t> &data = receiver_.frame();
+    ReceivedFrame frame;
+    frame.time = now;
+    frame.sent_time = sent() > 0 ? last_send_ : 0;
+    frame.size = static_cast<uint8_t>(data.size());
+    std::memcpy(frame.data, data.data(), data.size());
+    if (rx_queue_.push(frame)) {
+      frames_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    receiver_.reset();
+  }
+  receiver_.check_timeout(now);
+  idle_.store(!receiver_.in_frame(), std::memory_order_relaxed);
+  resyncs_.store(receiver_.resyncs(), std::memory_order_relaxed);
+
+  // Never talk over a reply; the first request goes out as soon as one is set. A read
+  // that overlaps set_transmit() fails and is retried on the next pass.
+  TransmitRequest request;
+  if (receiver_.in_frame() || !transmit_.read(&request)) {
+    return;
+  }
+  if (sent() == 0 || now - last_send_ >= request.interval_ms) {
+    device_->write_array(request.frame, CONTROLLER_FRAME_SIZE);
+    last_send_ = now;
+    sent_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void UartTask::set_transmit(const std::vector<uint8_t> &frame, uint32_t interval_ms) {
+  TransmitRequest request{};
+  std::copy_n(frame.begin(), std::min(frame.size(), sizeof(request.frame)), request.frame);
+  request.interval_ms = interval_ms;
+  transmit_.write(request);
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "esphome/components/uart/uart.h"
+#include "vevor_heater.h"
+#include "spsc_queue.h"
+#include <atomic>
+#include <vector>
+
+namespace esphome {
+namespace vevor_heater {
+
+static const size_t UART_TASK_QUEUE_SIZE = 8;  // Received frames waiting for the main loop
+static const uint32_t UART_TASK_POLL_MS = 5;   // 2-3 bytes at 4800 baud
+static const uint32_t UART_TASK_STACK_SIZE = 3072;
+
+// Complete frame handed from the UART task to the main loop
+struct ReceivedFrame {
+  uint32_t time;
+  uint32_t sent_time;  // Last request sent before the frame, 0 before the first
+  uint8_t size;
+  uint8_t data[HEATER_FRAME_SIZE];
+};
+
+// Controller frame the UART task repeats on its own schedule
+struct TransmitRequest {
+  uint8_t frame[CONTROLLER_FRAME_SIZE];
+  uint32_t interval_ms;
+};
+
+// Owns the heater UART on a dedicated FreeRTOS task, so frames are read and requests
+// sent on time even while the main loop is stalled by WiFi, API or web server work.
+// Frames go to the main loop through a lock-free queue and the next request comes
+// back through a seqlock; decoding, sensors and flash stay on the main loop.
+class UartTask {
+ public:
+  explicit UartTask(uart::UARTDevice *device) : device_(device) {}
+
+  // Starts the pinned task, false where FreeRTOS tasks are unavailable
+  bool start(uint8_t core, uint8_t priority);
+  // One pass of the task: drain received bytes, send the request when due
+  void poll(uint32_t now);
+
+  // Main loop side
+  bool pop_frame(ReceivedFrame *frame) { return rx_queue_.pop(frame); }
+  void set_transmit(const std::vector<uint8_t> &frame, uint32_t interval_ms);
+  bool is_idle() const { return idle_.load(std::memory_order_relaxed) && rx_queue_.empty(); }
+  uint32_t frames() const { return frames_.load(std::memory_order_relaxed); }
+  uint32_t dropped() const { return dropped_.load(std::memory_order_relaxed); }
+  uint32_t sent() const { return sent_.load(std::memory_order_relaxed); }
+  uint32_t resyncs() const { return resyncs_.load(std::memory_order_relaxed); }
+
+ protected:
+  static void task_main(void *arg);
+
+  uart::UARTDevice *device_;
+  SpscQueue<ReceivedFrame, UART_TASK_QUEUE_SIZE> rx_queue_;
+  Seqlock<TransmitRequest> transmit_;
+
+  // Task side only
+  FrameReceiver receiver_;
+  uint32_t last_send_{0};
+
+  // Written by the task, read by the main loop
+  std::atomic<bool> idle_{true};
+  std::atomic<uint32_t> frames_{0};
+  std::atomic<uint32_t> dropped_{0};  // Main loop fell more than a queue behind
+  std::atomic<uint32_t> sent_{0};
+  std::atomic<uint32_t> resyncs_{0};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -0,0 +1,121 @@
+#include "vevor_bus.h"
+#include "vevor_heater.h"
+#include "esphome/core/log.h"
+#include "esphome/core/hal.h"
+
+namespace esphome {
+namespace vevor_heater {
+
+static const char *const BUS_TAG = "vevor_heater.bus";
+
+static const uint32_t BUS_STATS_LOG_INTERVAL_MS = 300000;  // Link statistics summary every 5 minutes
+
+void VevorBus::add_device(VevorHeater *heater, uint8_t device_id) {
+  scheduler_.add_device(device_id);
+  heaters_.push_back(heater);
+  heater->set_bus(this);
+}
+
+void VevorBus::setup() {
+  // First slot opens after the guard time, never polled devices go first
+  uint32_t now = millis();
+  scheduler_.start(now);
+  last_stats_log_ = now;
+}
+
+void VevorBus::loop() {
+  uint32_t now = millis();
+
+  while (this->available()) {
+    uint8_t byte;
+    this->read_byte(&byte);
+    if (receiver_.feed(byte, now)) {
+      handle_frame(receiver_.frame(), now);
+      receiver_.reset();
+    }
+  }
+  if (receiver_.check_timeout(now)) {
+    ESP_LOGV(BUS_TAG, "Frame timeout, resetting");
+  }
+
+  int timed_out = scheduler_.check_timeout(now);
+  if (timed_out != BusScheduler::NO_SLOT) {
+    ESP_LOGV(BUS_TAG, "Device 0x%02X: no response within %u ms", scheduler_.device_id(timed_out),
+             (unsigned) scheduler_.slot_timeout());
+  }
+
+  // Open the next slot once the line has been quiet for the guard time
+  if (scheduler_.can_open_slot(now, receiver_.in_frame())) {
+    std::vector<BusDeviceState> states;
+    states.reserve(heaters_.size());
+    for (VevorHeater *heater : heaters_) {
+      states.push_back({heater->get_bus_priority(), heater->get_bus_poll_interval()});
+    }
+    int next = scheduler_.select_next_device(now, states);
+    if (next != BusScheduler::NO_SLOT) {
+      start_slot(next, now);
+    }
+  }
+
+  if (now - last_stats_log_ >= BUS_STATS_LOG_INTERVAL_MS) {
+    last_stats_log_ = now;
+    log_stats();
+  }
+}
+
+void VevorBus::start_slot(int index, uint32_t now) {
+  VevorHeater *heater = heaters_[index];
+  std::vector<uint8_t> frame = heater->build_controller_frame();
+  this->write_array(frame.data(), frame.size());
+  heater->on_request_sent(now);
+  scheduler_.open_slot(index, now);
+  ESP_LOGVV(BUS_TAG, "Slot opened for device 0x%02X", scheduler_.device_id(index));
+}
+
+void VevorBus::handle_frame(const std::vector<uint8_t> &frame, uint32_t now) {
+  // Our own request read back on a half-duplex line
+  if (is_controller_frame(frame)) {
+    scheduler_.count_echo();
+    ESP_LOGVV(BUS_TAG, "Ignoring controller frame echo");
+    return;
+  }
+
+  bool late = false;
+  int index = scheduler_.handle_reply(frame[1], now, &late);
+  if (index == BusScheduler::NO_SLOT) {
+    ESP_LOGV(BUS_TAG, "Frame from unknown device 0x%02X", frame[1]);
+    return;
+  }
+  if (late) {
+    ESP_LOGV(BUS_TAG, "Late response from device 0x%02X", frame[1]);
+  }
+
+  heaters_[index]->handle_bus_frame(frame);
+}
+
+void VevorBus::log_stats() {
+  for (size_t i = 0; i < scheduler_.device_count(); i++) {
+    const BusLinkStats &stats = scheduler_.stats(i);
+    uint32_t average = stats.responses > 0 ? static_cast<uint32_t>(stats.total_latency_ms / stats.responses) : 0;
+    ESP_LOGD(BUS_TAG, "Device 0x%02X: %u requests, %u responses, %u timeouts, %u late, latency avg %u ms max %u ms",
+             scheduler_.device_id(i), (unsigned) stats.requests, (unsigned) stats.responses, (unsigned) stats.timeouts,
+             (unsigned) stats.late_responses, (unsigned) average, (unsigned) stats.max_latency_ms);
+  }
+  if (scheduler_.echoes() > 0 || scheduler_.unknown_frames() > 0 || receiver_.resyncs() > 0) {
+    ESP_LOGD(BUS_TAG, "Bus: %u echoes suppressed, %u frames from unknown devices, %u resyncs on noise",
+             (unsigned) scheduler_.echoes(), (unsigned) scheduler_.unknown_frames(), (unsigned) receiver_.resyncs());
+  }
+}
+
+void VevorBus::dump_config() {
+  ESP_LOGCONFIG(BUS_TAG, "Vevor Heater Bus:");
+  ESP_LOGCONFIG(BUS_TAG, "  Devices: %u", (unsigned) scheduler_.device_count());
+  ESP_LOGCONFIG(BUS_TAG, "  Slot timeout: %u ms", (unsigned) scheduler_.slot_timeout());
+  for (size_t i = 0; i < scheduler_.device_count(); i++) {
+    ESP_LOGCONFIG(BUS_TAG, "  Device 0x%02X", scheduler_.device_id(i));
+  }
+  log_stats();
+}
+
+}  // namespace vevor_heater
+}  // namespace esphome
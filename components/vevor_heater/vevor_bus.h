@@ -0,0 +1,44 @@
+#pragma once
+
+#include "esphome/core/component.h"
+#include "esphome/components/uart/uart.h"
+#include "bus_scheduler.h"
+#include "frame_receiver.h"
+#include <vector>
+
+namespace esphome {
+namespace vevor_heater {
+
+class VevorHeater;
+
+// Arbitrates one half-duplex UART between several heaters. Each request opens a time
+// slot for one device and carries its request_address(); our own transmissions are
+// suppressed as echoes and BusScheduler matches replies and picks the next device.
+class VevorBus : public Component, public uart::UARTDevice {
+ public:
+  void add_device(VevorHeater *heater, uint8_t device_id);
+  void set_slot_timeout(uint32_t timeout_ms) { scheduler_.set_slot_timeout(timeout_ms); }
+
+  void setup() override;
+  void loop() override;
+  void dump_config() override;
+  float get_setup_priority() const override { return setup_priority::DATA; }
+
+  // No slot open and nothing arriving, safe for flash writes
+  bool is_idle() { return !scheduler_.slot_open() && !receiver_.in_frame() && this->available() == 0; }
+  size_t device_count() const { return scheduler_.device_count(); }
+  const BusLinkStats &get_stats(size_t index) const { return scheduler_.stats(index); }
+  void log_stats();
+
+ protected:
+  void start_slot(int index, uint32_t now);
+  void handle_frame(const std::vector<uint8_t> &frame, uint32_t now);
+
+  std::vector<VevorHeater *> heaters_;  // Indexed like the scheduler's devices
+  BusScheduler scheduler_;
+  FrameReceiver receiver_;
+  uint32_t last_stats_log_{0};
+};
+
+}  // namespace vevor_heater
+}  // namespace esphome
@@ -1,27 +1,37 @@
 #include "vevor_heater.h"
+#include "uart_task.h"
 #include "esphome/core/log.h"
 #include "esphome/core/helpers.h"
 #include "esphome/core/time.h"
 #ifdef USE_TIME
 #include "esphome/components/time/real_time_clock.h"
 #endif
+#include <algorithm>
 #include <cinttypes>
+#include <cmath>
 #include <ctime>
 
 namespace esphome {
 namespace vevor_heater {
 
-// Helper function for checksum calculation
-uint8_t calculate_checksum(const std::vector<uint8_t> &frame) {
-  if (frame.size() < 4) {
-    return 0;
+// Heater report as controller event, false for state bytes outside HeaterState
+static bool heater_state_event(HeaterState state, ControllerEvent *event) {
+  switch (state) {
+    case HeaterState::OFF: *event = ControllerEvent::HEATER_OFF; return true;
+    case HeaterState::POLLING_STATE:
+    case HeaterState::HEATING_UP: *event = ControllerEvent::HEATER_IGNITING; return true;
+    case HeaterState::STABLE_COMBUSTION: *event = ControllerEvent::HEATER_RUNNING; return true;
+    case HeaterState::STOPPING_COOLING: *event = ControllerEvent::HEATER_COOLING; return true;
+    default: return false;
   }
-  uint32_t sum = 0;
-  // Sum all bytes from index 2 to second-to-last byte
-  for (size_t i = 2; i < frame.size() - 1; ++i) {
-    sum += frame[i];
+}
+
+// Index into a packed upper-triangular CALIBRATION_BINS x CALIBRATION_BINS matrix
+static inline size_t calibration_tri_index(size_t row, size_t col) {
+  if (row > col) {
+    std::swap(row, col);
   }
-  return static_cast<uint8_t>(sum % 256);
+  return row * CALIBRATION_BINS - row * (row - 1) / 2 + (col - row);
 }
 
 void VevorHeater::setup() {
@@ -33,45 +43,129 @@ void VevorHeater::setup() {
     return;
   }
   
-  // Initialize state
+  // Initialize state, defaults first so restored intent and warm start override them
   this->current_state_ = HeaterState::OFF;
-  this->heater_enabled_ = false;
   this->antifreeze_active_ = false;
   this->power_level_ = static_cast<uint8_t>(default_power_percent_ / 10.0f);  // Convert % to 1-10 scale
+  this->configured_mode_ = control_mode_;
+  this->setup_time_ = millis();
+  this->controller_.set_start_guard([this]() { return this->can_start_heater(); });
+  this->controller_.set_transition_callback([this](ControllerState from, ControllerState to, ControllerEvent event) {
+    this->on_controller_transition(from, to, event);
+  });
+  
+  // Failed start counter, a latched lockout survives reboots
+  this->pref_restart_policy_ = global_preferences->make_preference<RestartPolicyData>(preference_hash("restart_policy"));
+  load_restart_policy();
+  
+  // Intent from before the reboot: finish an interrupted shutdown or resume heating
+  this->pref_controller_intent_ =
+      global_preferences->make_preference<ControllerIntentData>(preference_hash("controller_intent"));
+  load_controller_intent();
+  
+  // Last known heater report and mode, shown as stale until the first frame
+  this->pref_warm_start_ = global_preferences->make_preference<WarmStartData>(preference_hash("warm_start"));
+  load_warm_start();
   this->last_send_time_ = millis();
   this->last_received_time_ = millis();
-  this->external_temperature_ = NAN;
+  this->external_temperature_ = temperature_inputs_.value();
+  this->temperature_inputs_.set_on_change([this](float temperature) { this->external_temperature_ = temperature; });
   
   // Initialize fuel consumption tracking
   this->last_consumption_update_ = millis();
   this->current_day_ = get_days_since_epoch();
   
   // Setup persistent storage for fuel consumption
-  this->pref_fuel_consumption_ = global_preferences->make_preference<FuelConsumptionData>(fnv1_hash("fuel_consumption"));
+  this->pref_fuel_consumption_ = global_preferences->make_preference<FuelConsumptionData>(preference_hash("fuel_consumption"));
   load_fuel_consumption_data();
   
+  // Delivered heat counters, committed together with the fuel data
+  this->pref_energy_ = global_preferences->make_preference<EnergyData>(preference_hash("energy"));
+  load_energy_data();
+  
+  // Learned pump calibration (per power level correction of injected_per_pulse)
+  this->pref_pump_calibration_ = global_preferences->make_preference<PumpCalibrationData>(preference_hash("pump_calibration"));
+  load_pump_calibration_data();
+  
+  // Fuel tank model (only when a tank capacity is configured)
+  if (has_tank()) {
+    this->pref_fuel_tank_ = global_preferences->make_preference<FuelTankData>(preference_hash("fuel_tank"));
+    load_fuel_tank_data();
+  }
+  
+  // On-device schedule, runtime edits survive reboots unless the YAML schedule changed
+  this->pref_schedule_ = global_preferences->make_preference<ScheduleData>(preference_hash("heater_schedule"));
+  load_schedule_data();
+  
+  // Learned warm-up rates for optimal start
+  this->pref_warmup_model_ = global_preferences->make_preference<WarmupModelData>(preference_hash("warmup_model"));
+  load_warmup_model();
+  
+  // Persistent fault log
+  this->pref_fault_log_ = global_preferences->make_preference<FaultLogData>(preference_hash("fault_log"));
+  load_fault_log();
+  
+  // Runtime hour meters and service counters
+  this->pref_maintenance_ = global_preferences->make_preference<MaintenanceData>(preference_hash("maintenance"));
+  load_maintenance();
+  
+  if (controller_state_sensor_) {
+    controller_state_sensor_->publish_state(ControllerStateMachine::state_to_string(controller_.state()));
+  }
+  
   // Initialize hourly consumption sensor with initial value
   if (hourly_consumption_sensor_) {
     hourly_consumption_sensor_->publish_state(0.0f);
   }
   
+  status_snapshot_.set(status_snapshot_.controller_state, ControllerStateMachine::state_to_string(controller_.state()));
+  status_snapshot_.set(status_snapshot_.controller_state_code, static_cast<uint8_t>(controller_.state()));
+#ifdef USE_VEVOR_STATUS_ENDPOINT
+  if (status_web_base_ != nullptr) {
+    status_web_base_->init();
+    status_web_base_->add_handler(new VevorStatusHandler(this, status_path_));  // NOLINT
+    ESP_LOGCONFIG(TAG, "Status endpoint: %s", status_path_.c_str());
+  }
+#endif
+  
   ESP_LOGCONFIG(TAG, "Vevor Heater setup completed");
   ESP_LOGCONFIG(TAG, "Control mode: %s", control_mode_ == ControlMode::AUTOMATIC ? "Automatic" : "Manual");
   ESP_LOGCONFIG(TAG, "Default power level: %.0f%%", default_power_percent_);
   ESP_LOGCONFIG(TAG, "Injected per pulse: %.2f ml", injected_per_pulse_);
   ESP_LOGCONFIG(TAG, "Daily consumption: %.2f ml", daily_consumption_ml_);
   
-  // Send initial status request immediately after boot to get current heater state
-  send_controller_frame();
-  last_send_time_ = millis();
-  ESP_LOGD(TAG, "Initial status request sent");
+#ifdef USE_VEVOR_UART_TASK
+  if (bus_ == nullptr) {
+    uart_task_ = new UartTask(this);  // NOLINT
+    task_frame_.reserve(HEATER_FRAME_SIZE);
+    if (uart_task_->start(uart_task_core_, uart_task_priority_)) {
+      ESP_LOGCONFIG(TAG, "UART task started on core %u", uart_task_core_);
+    } else {
+      ESP_LOGE(TAG, "Could not start UART task, using the main loop");
+      delete uart_task_;  // NOLINT
+      uart_task_ = nullptr;
+    }
+  }
+#endif
+  
+  // Send initial status request immediately after boot to get current heater state,
+  // on a shared bus the first slot of every device does this; the UART task sends
+  // its first request as soon as update() hands it one
+  if (bus_ == nullptr && uart_task_ == nullptr) {
+    send_controller_frame();
+    last_send_time_ = millis();
+    ESP_LOGD(TAG, "Initial status request sent");
+  }
 }
 
 void VevorHeater::update() {
-  // Update external temperature reading if sensor is available
-  if (external_temperature_sensor_ != nullptr && external_temperature_sensor_->has_state()) {
-    external_temperature_ = external_temperature_sensor_->state;
-  }
+  // Temperature inputs update external_temperature_ as they publish, only expiry is polled
+  temperature_inputs_.check_stale(millis());
+  status_snapshot_.set(status_snapshot_.external_temperature, external_temperature_);
+  status_snapshot_.set(status_snapshot_.connected, is_connected());
+#ifdef USE_VEVOR_MQTT_TELEMETRY
+  check_telemetry();
+#endif
   
   // Check for daily reset
   check_daily_reset();
@@ -84,204 +178,319 @@ void VevorHeater::update() {
     handle_antifreeze_mode();
   }
   
-  // Always check for incoming data, regardless of state
-  check_uart_data();
+  // Fire due schedule transitions
+  handle_schedule();
+  
+  // Always check for incoming data, regardless of state (a shared bus delivers frames itself)
+  if (uart_task_ != nullptr) {
+    drain_uart_task();
+  } else if (bus_ == nullptr) {
+    check_uart_data();
+  }
+  
+  // Learn warm-up rates from the freshly parsed state
+  update_warmup_learning();
+  update_warm_start();
+  
+  // Receive buffer is drained and our next request is not sent yet, so this is the
+  // quietest point of the cycle to commit pending fuel data to flash
+  commit_pending_fuel_data();
   
   // Determine if we should send frames
   // Send frames at different intervals based on heater state:
   // - When heating or in non-OFF state: send every SEND_INTERVAL_MS (1 second)
-  // - When OFF and not enabled: send polling requests every polling_interval_ms_ (default 1 minute)
-  bool is_heating_or_active = heater_enabled_ || (current_state_ != HeaterState::OFF);
-  
+  // - When OFF and not enabled: send polling requests every polling_interval_ms_ (default 1 minute),
+  //   except right after boot until the first frame arrives
   uint32_t now = millis();
-  uint32_t send_interval = is_heating_or_active ? SEND_INTERVAL_MS : polling_interval_ms_;
+  uint32_t send_interval = get_bus_poll_interval();
   
-  if (is_heating_or_active) {
+  if (is_heating_or_active()) {
     // Handle communication timeout when actively controlling
     if (!is_connected()) {
       handle_communication_timeout();
     }
   }
   
-  // Send controller frame at appropriate intervals
-  if (now - last_send_time_ >= send_interval) {
+  // Send controller frame at appropriate intervals, the bus schedules shared slots
+  // and the UART task keeps its own time
+  if (uart_task_ != nullptr) {
+    uart_task_->set_transmit(build_controller_frame(), send_interval);
+  } else if (bus_ == nullptr && now - last_send_time_ >= send_interval) {
     send_controller_frame();
     last_send_time_ = now;
   }
   
+  // Predicted preheat lead for the current target, refreshed once a minute
+  if (now - last_preheat_publish_ >= 60000 || last_preheat_publish_ == 0) {
+    last_preheat_publish_ = now;
+    float target = target_temperature_;
+    uint8_t level = static_cast<uint8_t>(default_power_percent_ / 10.0f);
+    if (schedule_pending_slot_ != SCHEDULE_SLOT_NONE) {
+      const ScheduleSlot &slot = schedule_slots_[schedule_pending_slot_];
+      if (slot.target_temperature_x10 != SCHEDULE_NO_TARGET) {
+        target = slot.target_temperature_x10 / 10.0f;
+      }
+      if (slot.power_percent > 0) {
+        level = slot.power_percent / 10;
+      }
+    }
+    preheat_lead_minutes_ = predict_preheat_minutes(target, external_temperature_, level);
+    if (preheat_lead_time_sensor_) {
+      preheat_lead_time_sensor_->publish_state(preheat_lead_minutes_);
+    }
+  }
+  
+  // Remaining restart backoff, republished in 10 s steps while it counts down
+  if (restart_backoff_sensor_) {
+    uint32_t backoff_s = (restart_policy_.backoff_remaining(now) + 9999) / 10000 * 10;
+    if (backoff_s != last_backoff_published_) {
+      last_backoff_published_ = backoff_s;
+      restart_backoff_sensor_->publish_state(backoff_s);
+    }
+  }
+  
   // Update instantaneous hourly consumption rate (ml/h) based on current pump frequency
   if (hourly_consumption_sensor_) {
     // Calculate instantaneous consumption rate: Hz * ml/pulse * 3600 seconds/hour
-    float instantaneous_consumption_ml_per_hour = pump_frequency_ * injected_per_pulse_ * 3600.0f;
-    hourly_consumption_sensor_->publish_state(instantaneous_consumption_ml_per_hour);
+    hourly_consumption_sensor_->publish_state(get_instantaneous_consumption_rate());
+  }
+  if (thermal_power_sensor_) {
+    thermal_power_sensor_->publish_state(get_thermal_power());
+  }
+  publish_compensation_state();
+  publish_latency_state();
+}
+
+void VevorHeater::publish_compensation_state() {
+  uint8_t max_level = get_max_power_level();
+  if (max_level != last_max_power_level_) {
+    if (last_max_power_level_ != 0 || max_level < 10) {
+      ESP_LOGI(TAG, "Altitude %.0f m: max power %d%%", compensation_.altitude(), max_level * 10);
+    }
+    last_max_power_level_ = max_level;
+    if (effective_max_power_sensor_) {
+      effective_max_power_sensor_->publish_state(max_level * 10);
+    }
+  }
+  
+  // Follows the power level too, through the pump calibration
+  float effective_ml = get_effective_ml_per_pulse();
+  if (effective_injected_per_pulse_sensor_ && effective_ml != last_effective_ml_per_pulse_) {
+    last_effective_ml_per_pulse_ = effective_ml;
+    effective_injected_per_pulse_sensor_->publish_state(effective_ml);
+  }
+}
+
+void VevorHeater::check_latency_confirmed() {
+  if (!latency_.intent_pending()) {
+    return;
+  }
+  bool running = current_state_ == HeaterState::POLLING_STATE || current_state_ == HeaterState::HEATING_UP ||
+                 current_state_ == HeaterState::STABLE_COMBUSTION;
+  bool stopped = current_state_ == HeaterState::STOPPING_COOLING || current_state_ == HeaterState::OFF;
+  if (latency_start_ ? running : stopped) {
+    latency_.mark_confirmed(last_received_time_);
+  }
+}
+
+void VevorHeater::publish_latency_state() {
+  uint32_t now = millis();
+  latency_.check_timeout(now);
+  if (now - last_latency_publish_ < LATENCY_PUBLISH_INTERVAL_MS) {
+    return;
+  }
+  last_latency_publish_ = now;
+  
+  // Histograms only grow, an unchanged count means unchanged values
+  for (uint8_t metric = 0; metric < LATENCY_METRIC_COUNT; metric++) {
+    const LatencyHistogram &histogram = latency_.histogram(static_cast<LatencyMetric>(metric));
+    if (histogram.count() == latency_published_counts_[metric]) {
+      continue;
+    }
+    latency_published_counts_[metric] = histogram.count();
+    for (uint8_t stat = 0; stat < LATENCY_STAT_COUNT; stat++) {
+      if (latency_sensors_[metric][stat]) {
+        latency_sensors_[metric][stat]->publish_state(histogram.get(static_cast<LatencyStat>(stat)));
+      }
+    }
   }
 }
 
 void VevorHeater::check_uart_data() {
+  uint32_t now = millis();
   while (this->available()) {
     uint8_t byte;
     this->read_byte(&byte);
-    
-    // Look for frame start
-    if (!frame_sync_ && byte == FRAME_START) {
-      rx_buffer_.clear();
-      rx_buffer_.push_back(byte);
-      frame_sync_ = true;
-      ESP_LOGVV(TAG, "Frame start detected");
+    if (!receiver_.feed(byte, now)) {
       continue;
     }
     
-    if (frame_sync_) {
-      rx_buffer_.push_back(byte);
-      this->last_received_time_ = millis();
-      
-      // Check if we have enough bytes to determine frame length
-      if (rx_buffer_.size() >= 4) {
-        uint8_t expected_length = (rx_buffer_[3] == HEATER_FRAME_LENGTH) ? 56 : 15;
-        
-        if (rx_buffer_.size() >= expected_length) {
-          // Frame complete, process it
-          // First check if this is a controller frame echo (should be silently ignored)
-          if (rx_buffer_[1] == CONTROLLER_ID) {
-            ESP_LOGVV(TAG, "Ignoring controller frame echo");
-            rx_buffer_.clear();
-            frame_sync_ = false;
-            continue;
-          }
-          
-          if (validate_frame(rx_buffer_, expected_length)) {
-            process_heater_frame(rx_buffer_);
-          } else {
-            ESP_LOGW(TAG, "Invalid frame received");
-          }
-          
-          rx_buffer_.clear();
-          frame_sync_ = false;
-        } else if (rx_buffer_.size() > expected_length + 10) {
-          // Frame too long, reset
-          ESP_LOGW(TAG, "Frame too long, resetting");
-          rx_buffer_.clear();
-          frame_sync_ = false;
-        }
-      }
-    }
+    // Frame complete, process it
+    handle_received_frame(receiver_.frame(), now);
+    receiver_.reset();
   }
   
   // Timeout check for incomplete frames
-  if (frame_sync_ && (millis() - last_received_time_) > 100) {
+  if (receiver_.check_timeout(now)) {
     ESP_LOGV(TAG, "Frame timeout, resetting");
-    rx_buffer_.clear();
-    frame_sync_ = false;
   }
 }
 
-bool VevorHeater::validate_frame(const std::vector<uint8_t> &frame, uint8_t expected_length) {
-  if (frame.size() != expected_length) {
-    ESP_LOGV(TAG, "Frame length mismatch: expected %d, got %d", expected_length, frame.size());
-    return false;
+void VevorHeater::drain_uart_task() {
+  ReceivedFrame received;
+  while (uart_task_->pop_frame(&received)) {
+    // The task sends on its own schedule, its request time comes with each frame
+    if (received.sent_time != 0) {
+      latency_.mark_sent(received.sent_time);
+    }
+    task_frame_.assign(received.data, received.data + received.size);
+    handle_received_frame(task_frame_, received.time);
   }
-  
-  if (frame[0] != FRAME_START) {
-    ESP_LOGV(TAG, "Invalid frame start: 0x%02X", frame[0]);
-    return false;
+}
+
+void VevorHeater::handle_received_frame(const std::vector<uint8_t> &frame, uint32_t time) {
+  // First check if this is a controller frame echo (should be silently ignored)
+  if (is_controller_frame(frame)) {
+    ESP_LOGVV(TAG, "Ignoring controller frame echo");
+    return;
   }
-  
-  // Don't validate device ID - accept any device ID (like the working version does)
-  // Controller frame echoes are filtered out before calling this function
-  
-  // Verify checksum
-  uint8_t calculated_checksum = calculate_checksum(frame);
-  uint8_t received_checksum = frame[frame.size() - 1];
-  
-  if (calculated_checksum != received_checksum) {
-    ESP_LOGD(TAG, "Checksum mismatch: calculated 0x%02X, received 0x%02X", 
-             calculated_checksum, received_checksum);
-    // Don't reject on checksum mismatch - just log it
-    // The working version doesn't validate checksums either
+  if (accept_frame(frame)) {
+    this->last_received_time_ = time;
+    latency_.mark_response(time);
+    process_heater_frame(frame);
   }
-  
-  return true;
 }
 
-void VevorHeater::send_controller_frame() {
-  std::vector<uint8_t> frame;
-  
-  // Build controller frame
-  frame.push_back(FRAME_START);           // 0: Start byte
-  frame.push_back(CONTROLLER_ID);         // 1: Controller ID
-  
-  // Determine command based on current state and desired state
-  if (!heater_enabled_) {
-    if (current_state_ != HeaterState::OFF && current_state_ != HeaterState::STOPPING_COOLING) {
-      frame.push_back(0x06);              // 2: Stop command
-    } else {
-      frame.push_back(0x02);              // 2: Status request
-    }
-  } else {
-    if (current_state_ == HeaterState::OFF) {
-      frame.push_back(0x06);              // 2: Start command
-    } else {
-      frame.push_back(0x02);              // 2: Status request
-    }
+void VevorHeater::handle_bus_frame(const std::vector<uint8_t> &frame) {
+  this->last_received_time_ = millis();
+  if (accept_frame(frame)) {
+    latency_.mark_response(last_received_time_);
+    process_heater_frame(frame);
   }
-  
-  frame.push_back(CONTROLLER_FRAME_LENGTH); // 3: Frame length
-  frame.push_back(0x00);                    // 4: Unknown
-  frame.push_back(0x00);                    // 5: Unknown
-  frame.push_back(0x00);                    // 6: Unknown
-  frame.push_back(0x00);                    // 7: Unknown
-  frame.push_back(power_level_);            // 8: Power level (1-10)
-  
-  // Set requested state
-  if (!heater_enabled_) {
-    if (current_state_ != HeaterState::OFF && current_state_ != HeaterState::STOPPING_COOLING) {
-      frame.push_back(0x05);              // 9: Set off
-    } else {
-      frame.push_back(0x02);              // 9: Off
-    }
-  } else {
-    if (current_state_ == HeaterState::OFF) {
-      frame.push_back(0x06);              // 9: Start
-    } else {
-      frame.push_back(0x08);              // 9: Running
+}
+
+bool VevorHeater::accept_frame(const std::vector<uint8_t> &frame) {
+  FrameError error = validate_frame(frame);
+  if (error == FrameError::CHECKSUM) {
+    checksum_mismatches_++;
+    ESP_LOGD(TAG, "Checksum mismatch: calculated 0x%02X, received 0x%02X", calculate_checksum(frame), frame.back());
+    // The original firmware never checked checksums and heaters have been run that way,
+    // so a mismatch only drops the frame when reject_bad_checksum is set
+    if (!reject_bad_checksum_) {
+      return true;
     }
   }
+  if (error != FrameError::NONE) {
+    ESP_LOGW(TAG, "Invalid frame received from device 0x%02X: %s", device_id_, frame_error_to_string(error));
+    return false;
+  }
+  return true;
+}
+
+BusPriority VevorHeater::get_bus_priority() const {
+  ControllerState state = controller_.state();
+  if (state == ControllerState::STARTING || state == ControllerState::STOPPING ||
+      current_state_ == HeaterState::POLLING_STATE || current_state_ == HeaterState::HEATING_UP ||
+      current_state_ == HeaterState::STOPPING_COOLING) {
+    return BusPriority::TRANSITIONAL;
+  }
+  return is_heating_or_active() ? BusPriority::ACTIVE : BusPriority::IDLE;
+}
+
+uint32_t VevorHeater::preference_hash(const char *key) const {
+  // Keys of the default heater stay unsalted so single heater installs keep their data
+  uint32_t hash = fnv1_hash(key);
+  return device_id_ == HEATER_ID ? hash : hash ^ device_id_;
+}
+
+void VevorHeater::send_controller_frame() {
+  std::vector<uint8_t> frame = build_controller_frame();
+  this->write_array(frame.data(), frame.size());
+  latency_.mark_sent(millis());
   
-  frame.push_back(0x00);                    // 10: Unknown
-  frame.push_back(0x00);                    // 11: Unknown
-  frame.push_back(0x00);                    // 12: Unknown
-  frame.push_back(0x00);                    // 13: Unknown
-  frame.push_back(0x00);                    // 14: Unknown
+  ESP_LOGD(TAG, "Sent controller frame: controller=%s, power=%d, state=0x%02X", 
+           ControllerStateMachine::state_to_string(controller_.state()), power_level_,
+           frame[HEATER_PROFILE.request.requested_state]);
+}
+
+std::vector<uint8_t> VevorHeater::build_controller_frame() {
+  // Bytes the profile does not name are unknown and sent as zero
+  std::vector<uint8_t> frame(CONTROLLER_FRAME_SIZE, 0x00);
+  const RequestLayout &layout = HEATER_PROFILE.request;
+  latency_.mark_built(millis());
   
-  // Calculate and add checksum
-  uint8_t checksum = calculate_checksum(frame);
-  frame.push_back(checksum);                // 15: Checksum
+  // Build controller frame
+  frame[0] = FRAME_START;                 // Start byte
+  frame[1] = addressed_requests_ ? request_address(device_id_) : CONTROLLER_ID;  // Controller ID
+  frame[3] = CONTROLLER_FRAME_LENGTH;     // Frame length
   
-  // Send frame
-  this->write_array(frame.data(), frame.size());
+  // Command bytes follow from the controller state and the last heater report
+  ControllerCommand command = encode_request(controller_.request());
+  frame[layout.command] = command.command;                  // Command (Vevor: 0x02 status, 0x06 start/stop)
+  frame[layout.power_level] = encode_power_level(get_effective_power_level());
+  frame[layout.requested_state] = command.requested_state;  // Requested state
   
-  ESP_LOGD(TAG, "Sent controller frame: enabled=%s, power=%d, state=0x%02X", 
-           YESNO(heater_enabled_), power_level_, frame[9]);
+  // Calculate and add checksum
+  frame[CONTROLLER_FRAME_SIZE - 1] = calculate_checksum(frame);
+  return frame;
 }
 
 void VevorHeater::process_heater_frame(const std::vector<uint8_t> &frame) {
-  if (frame[3] == HEATER_FRAME_LENGTH && frame.size() >= 56) {
+  if (frame[3] == HEATER_FRAME_LENGTH && frame.size() >= HEATER_FRAME_SIZE) {
     // Long frame from heater
     ESP_LOGV(TAG, "Processing heater status frame");
     
-    // Parse heater state (byte 5)
-    uint8_t state_raw = frame[5];
+    // Parse heater state
+    uint8_t state_raw = frame[HEATER_PROFILE.status.state];
     HeaterState new_state = static_cast<HeaterState>(state_raw);
+    HeaterState old_state = current_state_;
     
     if (new_state != current_state_) {
       current_state_ = new_state;
       ESP_LOGD(TAG, "Heater state changed to: %s", state_to_string(current_state_));
+      check_state_faults(old_state, new_state, frame);
     }
     
     // Update all sensors
     update_sensors(frame);
+    update_maintenance(old_state);
+    if (!frame_received_) {
+      frame_received_ = true;
+      status_snapshot_.set(status_snapshot_.stale, false);
+      ESP_LOGD(TAG, "First heater frame %u ms after boot", (unsigned) (millis() - setup_time_));
+    }
+    
+    // Resume a heater that was running before the reboot before this report is seen as
+    // an unrequested run - otherwise the first frame would stop it
+    if (resume_pending_) {
+      resume_pending_ = false;
+      ESP_LOGI(TAG, "Resuming heater after reboot (heater %s)", state_to_string(current_state_));
+      uint8_t level = power_level_;
+      turn_on();
+      power_level_ = level;
+    }
+    
+    // Every report drives the controller, repeated ones are no-ops in the transition table
+    ControllerEvent heater_event;
+    if (heater_state_event(new_state, &heater_event)) {
+      controller_.dispatch(heater_event);
+    }
+    update_controller_intent();
+    check_latency_confirmed();
+    
+    check_frame_faults(frame);
+    check_start_confirmed();
+    
+    if (frame_capture_.is_enabled()) {
+      frame_capture_.add(frame.data(), state_raw, frame[HEATER_PROFILE.status.power_level],
+                         frame[HEATER_PROFILE.status.input_voltage] / 10.0f);
+    }
+    
+#ifdef USE_VEVOR_MQTT_TELEMETRY
+    check_telemetry();
+#endif
     
-  } else if (frame[3] == CONTROLLER_FRAME_LENGTH && frame.size() >= 15) {
+  } else if (frame[3] == CONTROLLER_FRAME_LENGTH && frame.size() >= CONTROLLER_FRAME_SIZE) {
     // Short frame (controller echo)
     ESP_LOGVV(TAG, "Received controller frame echo");
     // Usually just an echo of our own transmission
@@ -289,72 +498,105 @@ void VevorHeater::process_heater_frame(const std::vector<uint8_t> &frame) {
 }
 
 void VevorHeater::update_sensors(const std::vector<uint8_t> &frame) {
+  // Fields below are read at the profile's fixed offsets
+  if (frame.size() < HEATER_FRAME_SIZE) {
+    return;
+  }
+  const StatusLayout &layout = HEATER_PROFILE.status;
+  
   // State sensor
   if (state_sensor_) {
     state_sensor_->publish_state(state_to_string(current_state_));
   }
   
-  // Power level (byte 6)
-  uint8_t power_level_raw = frame[6];
-  if (power_level_sensor_ && power_level_raw > 0 && power_level_raw <= 10) {
-    power_level_sensor_->publish_state(power_level_raw * 10);
+  // Power level, 0 while the heater reports none
+  uint8_t power_level_raw = frame[layout.power_level];
+  reported_power_level_ = is_valid_power_byte(power_level_raw) ? decode_power_level(power_level_raw) : 0;
+  if (power_level_sensor_ && reported_power_level_ > 0) {
+    power_level_sensor_->publish_state(reported_power_level_ * 10);
   }
   
-  // Input voltage (byte 11)
-  uint8_t voltage_raw = frame[11];
-  if (input_voltage_sensor_ && voltage_raw > 0) {
+  // Input voltage - parsed without a sensor too, the start guard needs it
+  uint8_t voltage_raw = frame[layout.input_voltage];
+  if (voltage_raw > 0) {
     input_voltage_ = voltage_raw / 10.0f;
-    input_voltage_sensor_->publish_state(input_voltage_);
+    if (input_voltage_sensor_) {
+      input_voltage_sensor_->publish_state(input_voltage_);
+    }
   }
   
-  // Glow plug current (byte 13)
-  uint8_t glow_current_raw = frame[13];
+  // Glow plug current
+  uint8_t glow_current_raw = frame[layout.glow_plug_current];
   if (glow_plug_current_sensor_) {
     glow_plug_current_ = glow_current_raw;
     glow_plug_current_sensor_->publish_state(glow_plug_current_);
   }
   
-  // Cooling down flag (byte 14)
-  uint8_t cooling_flag = frame[14];
+  // Cooling down flag
+  uint8_t cooling_flag = frame[layout.cooling_flag];
   if (cooling_down_sensor_) {
     cooling_down_ = (cooling_flag != 0);
     cooling_down_sensor_->publish_state(cooling_down_);
   }
   
-  // Heat exchanger temperature (bytes 16-17) - Signed value for negative temps
-  if (heat_exchanger_temperature_sensor_ && frame.size() > 17) {
-    // Read as signed int16 to handle negative temperatures correctly
-    int16_t temp_raw = static_cast<int16_t>(read_uint16_be(frame, 16));
-    heat_exchanger_temperature_ = temp_raw / 10.0f;
+  // Heat exchanger temperature - Signed value for negative temps, parsed without a
+  // sensor too since the restart guard needs it
+  // Read as signed int16 to handle negative temperatures correctly
+  int16_t temp_raw = static_cast<int16_t>(read_uint16_be(frame, layout.heat_exchanger));
+  heat_exchanger_temperature_ = temp_raw / 10.0f;
+  if (heat_exchanger_temperature_sensor_) {
     heat_exchanger_temperature_sensor_->publish_state(heat_exchanger_temperature_);
-    
-    // Update current temperature for climate control (no duplicate temperature sensor)
-    current_temperature_ = heat_exchanger_temperature_;
   }
   
-  // State duration (bytes 20-21)
-  if (state_duration_sensor_ && frame.size() > 21) {
-    uint16_t duration_raw = read_uint16_be(frame, 20);
-    state_duration_sensor_->publish_state(duration_raw);
+  // Update current temperature for climate control (no duplicate temperature sensor)
+  current_temperature_ = heat_exchanger_temperature_;
+  
+  // State duration
+  state_duration_ = read_uint16_be(frame, layout.state_duration);
+  if (state_duration_sensor_) {
+    state_duration_sensor_->publish_state(state_duration_);
   }
   
-  // Pump frequency (byte 23)
-  if (pump_frequency_sensor_ && frame.size() > 23) {
-    uint8_t pump_raw = frame[23];
-    float new_pump_frequency = pump_raw / 10.0f;
-    
-    // Update fuel consumption based on pump frequency change
-    update_fuel_consumption(new_pump_frequency);
-    
-    pump_frequency_ = new_pump_frequency;
+  // Cooldown timer, the heater's own state duration so it survives controller reboots
+  uint16_t cooldown = current_state_ == HeaterState::STOPPING_COOLING ? state_duration_ : 0;
+  if (cooldown != cooldown_seconds_ || (cooldown_time_sensor_ && !cooldown_time_sensor_->has_state())) {
+    cooldown_seconds_ = cooldown;
+    if (cooldown_time_sensor_) {
+      cooldown_time_sensor_->publish_state(cooldown_seconds_);
+    }
+  }
+  
+  // Pump frequency - parsed and integrated without a sensor too, fuel tracking needs it
+  uint8_t pump_raw = frame[layout.pump_frequency];
+  float new_pump_frequency = pump_raw / 10.0f;
+  
+  // Update fuel consumption based on pump frequency change
+  update_fuel_consumption(new_pump_frequency);
+  
+  pump_frequency_ = new_pump_frequency;
+  if (pump_frequency_sensor_) {
     pump_frequency_sensor_->publish_state(pump_frequency_);
   }
   
-  // Fan speed (bytes 28-29)
-  if (fan_speed_sensor_ && frame.size() > 29) {
-    fan_speed_ = read_uint16_be(frame, 28);
+  // Fan speed
+  if (fan_speed_sensor_) {
+    fan_speed_ = read_uint16_be(frame, layout.fan_speed);
     fan_speed_sensor_->publish_state(fan_speed_);
   }
+  
+  // Status snapshot, read from the frame so it is complete without the matching sensors
+  StatusSnapshot &snap = status_snapshot_;
+  snap.set(snap.heater_state, state_to_string(current_state_));
+  snap.set(snap.heater_state_code, static_cast<uint8_t>(current_state_));
+  snap.set(snap.power_level, reported_power_level_);
+  snap.set(snap.input_voltage, input_voltage_);
+  snap.set(snap.glow_plug_current, static_cast<float>(frame[layout.glow_plug_current]));
+  snap.set(snap.cooling_down, frame[layout.cooling_flag] != 0);
+  snap.set(snap.heat_exchanger_temperature, heat_exchanger_temperature_);
+  snap.set(snap.state_duration, state_duration_);
+  snap.set(snap.pump_frequency, pump_frequency_);
+  snap.set(snap.fan_speed, read_uint16_be(frame, layout.fan_speed));
+  snap.set(snap.consumption_rate, get_instantaneous_consumption_rate());
 }
 
 void VevorHeater::update_fuel_consumption(float pump_frequency) {
@@ -369,19 +611,39 @@ void VevorHeater::update_fuel_consumption(float pump_frequency) {
     if (pump_frequency > 0.0f && time_delta > 0) {
       // Calculate fuel consumption based on pump frequency and time
       // pump_frequency is in Hz (pulses per second)
+      // Pulses are normalised to the reference fuel temperature, so the refill calibration
+      // learns the pump and not the weather
       float time_seconds = time_delta / 1000.0f;
-      float pulses = pump_frequency * time_seconds;
-      float consumed_ml = pulses * injected_per_pulse_;
+      float pulses = pump_frequency * time_seconds * compensation_.injected_factor();
+      
+      // Apply learned per power level calibration; totals are kept in calibrated pulses
+      // so total consumption still follows injected_per_pulse adjustments
+      uint8_t level = get_fuel_power_level();
+      float calibrated_pulses = pulses * get_pump_calibration_factor(level);
+      float consumed_ml = calibrated_pulses * injected_per_pulse_;
       
       // Update daily consumption counter
       daily_consumption_ml_ += consumed_ml;
-      total_fuel_pulses_ += pulses;  // Keep as float for precision
+      total_fuel_pulses_ += calibrated_pulses;  // Keep as float for precision
+      
+      // Raw pulses since the last refill feed the calibration fit
+      if (level >= 1 && level <= CALIBRATION_BINS) {
+        refill_pulses_[level - 1] += pulses;
+        calibration_dirty_ = true;
+      }
+      fuel_since_refill_ml_ += consumed_ml;
+      add_delivered_energy(consumed_ml, level);
       
       // Update total consumption
       total_consumption_ml_ = total_fuel_pulses_ * injected_per_pulse_;
       
-      // Calculate instantaneous consumption rate for logging
-      float instantaneous_ml_per_hour = pump_frequency * injected_per_pulse_ * 3600.0f;
+      // Instantaneous rate from what was just integrated, so it carries the same fuel
+      // temperature and calibration corrections as the consumption and tank totals
+      float instantaneous_ml_per_hour = consumed_ml / time_seconds * 3600.0f;
+      
+      if (has_tank()) {
+        update_fuel_tank(consumed_ml, instantaneous_ml_per_hour, level, time_seconds);
+      }
       
       ESP_LOGVV(TAG, "Fuel consumption rate: %.2f ml/h, total daily: %.2f ml", 
                 instantaneous_ml_per_hour, daily_consumption_ml_);
@@ -396,17 +658,130 @@ void VevorHeater::update_fuel_consumption(float pump_frequency) {
         total_consumption_sensor_->publish_state(total_consumption_ml_);
       }
       
-      // Save data periodically (every 30 seconds to reduce flash wear)
-      static uint32_t last_save = 0;
-      if (current_time - last_save > 30000) {
-        save_fuel_consumption_data();
-        last_save = current_time;
+      if (fuel_since_refill_sensor_) {
+        fuel_since_refill_sensor_->publish_state(fuel_since_refill_ml_);
       }
+      publish_energy_state();
+      
+      // Never write flash from frame processing - just snapshot and let update() commit it
+      mark_fuel_data_dirty();
     }
   }
   
   last_pump_frequency_ = pump_frequency;
   last_consumption_update_ = current_time;
+  
+  if (has_tank()) {
+    publish_fuel_tank_state();
+  }
+}
+
+void VevorHeater::update_fuel_tank(float consumed_ml, float rate_ml_h, uint8_t level, float time_seconds) {
+  tank_remaining_ml_ = std::max(0.0f, tank_remaining_ml_ - consumed_ml);
+  
+  // Time-weighted EWMA so irregular frame spacing does not skew the burn rate
+  if (level >= 1 && level <= CALIBRATION_BINS) {
+    float &burn_rate = burn_rate_ml_h_[level - 1];
+    if (burn_rate <= 0.0f) {
+      burn_rate = rate_ml_h;
+    } else {
+      float alpha = 1.0f - std::exp(-time_seconds / BURN_RATE_TIME_CONSTANT_S);
+      burn_rate += alpha * (rate_ml_h - burn_rate);
+    }
+  }
+  
+  tank_dirty_ = true;
+}
+
+float VevorHeater::get_tank_hours_left() const {
+  if (!has_tank()) {
+    return NAN;
+  }
+  // Estimate at the level the heater runs (or would run) at; fall back to the live rate
+  uint8_t level = get_fuel_power_level();
+  float rate = (level >= 1 && level <= CALIBRATION_BINS) ? burn_rate_ml_h_[level - 1] : 0.0f;
+  if (rate <= 0.0f) {
+    rate = get_instantaneous_consumption_rate();
+  }
+  if (rate <= 0.0f) {
+    return NAN;
+  }
+  return tank_remaining_ml_ / rate;
+}
+
+void VevorHeater::publish_fuel_tank_state() {
+  float level_percent = get_tank_level_percent();
+  
+  if (tank_remaining_sensor_) {
+    tank_remaining_sensor_->publish_state(tank_remaining_ml_ / 1000.0f);
+  }
+  if (tank_level_sensor_) {
+    tank_level_sensor_->publish_state(level_percent);
+  }
+  if (tank_hours_left_sensor_) {
+    tank_hours_left_sensor_->publish_state(get_tank_hours_left());
+  }
+  
+  // Hysteresis of 2% so the flag does not chatter while fuel sloshes around the threshold
+  bool low_fuel = low_fuel_ ? level_percent < low_fuel_threshold_percent_ + 2.0f
+                            : level_percent < low_fuel_threshold_percent_;
+  if (low_fuel != low_fuel_) {
+    low_fuel_ = low_fuel;
+    if (low_fuel_) {
+      ESP_LOGW(TAG, "Low fuel: %.1f%% (%.2f L) remaining", level_percent, tank_remaining_ml_ / 1000.0f);
+    } else {
+      ESP_LOGI(TAG, "Fuel level back above low fuel threshold");
+    }
+    if (low_fuel_sensor_) {
+      low_fuel_sensor_->publish_state(low_fuel_);
+    }
+  }
+  status_snapshot_.set(status_snapshot_.tank_level, level_percent);
+  status_snapshot_.set(status_snapshot_.low_fuel, low_fuel_);
+  
+  // Stop while there is still fuel in the line - running dry airlocks the pump
+  if (low_fuel_ && low_fuel_shutdown_ && controller_.is_heat_requested()) {
+    ESP_LOGW(TAG, "Low fuel shutdown, stopping heater");
+    turn_off();
+    antifreeze_active_ = false;
+  }
+}
+
+void VevorHeater::refill_tank() {
+  if (!has_tank()) {
+    ESP_LOGW(TAG, "Cannot refill tank: tank_capacity not configured");
+    return;
+  }
+  ESP_LOGI(TAG, "Tank refilled to %.1f L", tank_capacity_ml_ / 1000.0f);
+  tank_remaining_ml_ = tank_capacity_ml_;
+  tank_dirty_ = true;
+  mark_fuel_data_dirty(true);
+  publish_fuel_tank_state();
+}
+
+void VevorHeater::save_fuel_tank_data() {
+  FuelTankData data;
+  data.remaining_ml = tank_remaining_ml_;
+  std::copy(std::begin(burn_rate_ml_h_), std::end(burn_rate_ml_h_), data.burn_rate_ml_h);
+  
+  if (!pref_fuel_tank_.save(&data)) {
+    ESP_LOGW(TAG, "Failed to save fuel tank data");
+  }
+}
+
+void VevorHeater::load_fuel_tank_data() {
+  FuelTankData data;
+  if (pref_fuel_tank_.load(&data) && !std::isnan(data.remaining_ml)) {
+    tank_remaining_ml_ = std::max(0.0f, std::min(tank_capacity_ml_, data.remaining_ml));
+    std::copy(std::begin(data.burn_rate_ml_h), std::end(data.burn_rate_ml_h), burn_rate_ml_h_);
+    ESP_LOGI(TAG, "Loaded fuel tank: %.2f L remaining", tank_remaining_ml_ / 1000.0f);
+  } else {
+    // Assume a full tank on first use, the user confirms with a refill
+    tank_remaining_ml_ = tank_capacity_ml_;
+    ESP_LOGI(TAG, "No fuel tank data found, assuming full tank");
+  }
+  
+  publish_fuel_tank_state();
 }
 
 void VevorHeater::check_daily_reset() {
@@ -415,11 +790,13 @@ void VevorHeater::check_daily_reset() {
     ESP_LOGI(TAG, "New day detected, resetting daily consumption counter");
     current_day_ = today;
     daily_consumption_ml_ = 0.0f;
-    save_fuel_consumption_data();
+    daily_energy_wh_ = 0;
+    mark_fuel_data_dirty(true);
     
     if (daily_consumption_sensor_) {
       daily_consumption_sensor_->publish_state(daily_consumption_ml_);
     }
+    publish_energy_state();
   }
 }
 
@@ -468,11 +845,148 @@ uint32_t VevorHeater::get_days_since_epoch() {
   return now / (24 * 60 * 60);
 }
 
+uint32_t VevorHeater::get_unix_time() {
+  std::time_t now = std::time(nullptr);
+#ifdef USE_TIME
+  if (time_component_ != nullptr && time_component_->now().is_valid()) {
+    now = time_component_->now().timestamp;
+  }
+#endif
+  return now >= 1609459200 ? static_cast<uint32_t>(now) : 0;  // 0 until time is synced
+}
+
+void VevorHeater::mark_fuel_data_dirty(bool urgent) {
+  // Fill the spare buffer, then flip so the committed snapshot is always a complete one
+  uint8_t next = fuel_snapshot_index_ ^ 1;
+  fuel_snapshot_[next].daily_consumption_ml = daily_consumption_ml_;
+  fuel_snapshot_[next].last_reset_day = current_day_;
+  fuel_snapshot_[next].total_pulses = total_fuel_pulses_;
+  energy_snapshot_[next].daily_wh = daily_energy_wh_;
+  energy_snapshot_[next].total_wh = total_energy_wh_;
+  energy_snapshot_[next].fraction_wh = energy_fraction_wh_;
+  energy_snapshot_[next].last_reset_day = current_day_;
+  fuel_snapshot_index_ = next;
+  
+  // Every fuel change passes through here
+  status_snapshot_.set(status_snapshot_.daily_consumption, daily_consumption_ml_);
+  status_snapshot_.set(status_snapshot_.total_consumption, total_consumption_ml_);
+  
+  if (!fuel_data_dirty_) {
+    fuel_data_dirty_ = true;
+    fuel_dirty_since_ = millis();
+  }
+  if (urgent) {
+    fuel_commit_urgent_ = true;
+  }
+}
+
+#ifdef USE_VEVOR_MQTT_TELEMETRY
+void VevorHeater::check_telemetry() {
+  uint32_t now = millis();
+  bool state_changed = status_snapshot_.heater_state_code != telemetry_heater_state_ ||
+                       status_snapshot_.controller_state_code != telemetry_controller_state_;
+  bool due = now - last_telemetry_publish_ >= telemetry_interval_ms_ || telemetry_sequence_ == 0;
+  if (!due && !(state_changed && telemetry_on_state_change_)) {
+    return;
+  }
+  if (mqtt::global_mqtt_client == nullptr || !mqtt::global_mqtt_client->is_connected()) {
+    return;
+  }
+  
+  uint8_t payload[TELEMETRY_PAYLOAD_SIZE];
+  status_snapshot_.to_binary(payload, telemetry_sequence_);
+  if (!mqtt::global_mqtt_client->publish(telemetry_topic_, reinterpret_cast<const char *>(payload),
+                                         TELEMETRY_PAYLOAD_SIZE)) {
+    ESP_LOGW(TAG, "Telemetry publish failed");
+    return;
+  }
+  ESP_LOGV(TAG, "Telemetry #%u published%s", (unsigned) telemetry_sequence_, state_changed ? " (state change)" : "");
+  telemetry_sequence_++;
+  last_telemetry_publish_ = now;
+  telemetry_heater_state_ = status_snapshot_.heater_state_code;
+  telemetry_controller_state_ = status_snapshot_.controller_state_code;
+}
+#endif
+
+bool VevorHeater::is_uart_idle() {
+  // Idle when no frame is being assembled and nothing is waiting in the RX FIFO
+  if (bus_ != nullptr) {
+    return bus_->is_idle();
+  }
+  if (uart_task_ != nullptr) {
+    return uart_task_->is_idle();
+  }
+  return !receiver_.in_frame() && this->available() == 0;
+}
+
+void VevorHeater::commit_pending_fuel_data(bool force) {
+  if (!fuel_data_dirty_) {
+    return;
+  }
+  
+  if (!force) {
+    uint32_t dirty_for = millis() - fuel_dirty_since_;
+    bool deadline_reached = dirty_for >= fuel_save_interval_ms_;
+    // Start looking for an idle slot at 3/4 of the window so the deadline is rarely needed
+    bool window_open = fuel_commit_urgent_ || dirty_for >= (fuel_save_interval_ms_ / 4) * 3;
+    
+    if (!window_open) {
+      return;
+    }
+    if (!deadline_reached && !is_uart_idle()) {
+      ESP_LOGVV(TAG, "Fuel data commit postponed, UART busy");
+      return;
+    }
+  }
+  
+  save_fuel_consumption_data();
+  if (calibration_dirty_) {
+    save_pump_calibration_data();
+    calibration_dirty_ = false;
+  }
+  if (tank_dirty_) {
+    save_fuel_tank_data();
+    tank_dirty_ = false;
+  }
+  if (warmup_dirty_) {
+    save_warmup_model();
+    warmup_dirty_ = false;
+  }
+  if (fault_log_dirty_) {
+    save_fault_log();
+    fault_log_dirty_ = false;
+  }
+  if (schedule_dirty_) {
+    save_schedule_data();
+    schedule_dirty_ = false;
+  }
+  if (restart_dirty_) {
+    save_restart_policy();
+    restart_dirty_ = false;
+  }
+  if (intent_dirty_) {
+    save_controller_intent();
+    intent_dirty_ = false;
+  }
+  if (warm_start_dirty_) {
+    save_warm_start();
+    warm_start_dirty_ = false;
+  }
+  if (maintenance_dirty_) {
+    save_maintenance();
+    maintenance_dirty_ = false;
+  }
+  // save() only queues the data, the flash write happens here at the quiet point instead
+  // of at the next flash_write_interval
+  if (!global_preferences->sync()) {
+    ESP_LOGW(TAG, "Failed to write preferences to flash");
+  }
+  fuel_data_dirty_ = false;
+  fuel_commit_urgent_ = false;
+}
+
 void VevorHeater::save_fuel_consumption_data() {
-  FuelConsumptionData data;
-  data.daily_consumption_ml = daily_consumption_ml_;
-  data.last_reset_day = current_day_;
-  data.total_pulses = total_fuel_pulses_;
+  const FuelConsumptionData &data = fuel_snapshot_[fuel_snapshot_index_];
   
   if (pref_fuel_consumption_.save(&data)) {
     ESP_LOGD(TAG, "Fuel consumption data saved: %.2f ml, day %d", 
@@ -480,6 +994,9 @@ void VevorHeater::save_fuel_consumption_data() {
   } else {
     ESP_LOGW(TAG, "Failed to save fuel consumption data");
   }
+  if (!pref_energy_.save(&energy_snapshot_[fuel_snapshot_index_])) {
+    ESP_LOGW(TAG, "Failed to save energy data");
+  }
 }
 
 void VevorHeater::load_fuel_consumption_data() {
@@ -511,41 +1028,291 @@ void VevorHeater::load_fuel_consumption_data() {
   if (total_consumption_sensor_) {
     total_consumption_sensor_->publish_state(total_consumption_ml_);
   }
+  
+  // Seed the snapshot buffers so a forced commit before the first change is harmless
+  fuel_snapshot_[0].daily_consumption_ml = daily_consumption_ml_;
+  fuel_snapshot_[0].last_reset_day = current_day_;
+  fuel_snapshot_[0].total_pulses = total_fuel_pulses_;
+  fuel_snapshot_[1] = fuel_snapshot_[0];
 }
 
-void VevorHeater::reset_daily_consumption() {
-  ESP_LOGI(TAG, "Manual reset of daily consumption counter");
-  daily_consumption_ml_ = 0.0f;
-  save_fuel_consumption_data();
+void VevorHeater::load_energy_data() {
+  EnergyData data;
+  if (pref_energy_.load(&data) && !std::isnan(data.fraction_wh)) {
+    total_energy_wh_ = data.total_wh;
+    daily_energy_wh_ = data.last_reset_day == current_day_ ? data.daily_wh : 0;
+    energy_fraction_wh_ = std::max(0.0f, std::min(data.fraction_wh, 1.0f));
+    ESP_LOGI(TAG, "Loaded energy data: %.2f kWh today, %.1f kWh total", get_daily_energy(), get_total_energy());
+  } else {
+    ESP_LOGI(TAG, "No energy data found, starting fresh");
+  }
+  publish_energy_state();
   
-  if (daily_consumption_sensor_) {
-    daily_consumption_sensor_->publish_state(daily_consumption_ml_);
+  energy_snapshot_[0].daily_wh = daily_energy_wh_;
+  energy_snapshot_[0].total_wh = total_energy_wh_;
+  energy_snapshot_[0].fraction_wh = energy_fraction_wh_;
+  energy_snapshot_[0].last_reset_day = current_day_;
+  energy_snapshot_[1] = energy_snapshot_[0];
+}
+
+void VevorHeater::add_delivered_energy(float consumed_ml, uint8_t level) {
+  // kWh/L equals Wh/ml, so the heating value converts the fuel directly
+  energy_fraction_wh_ += consumed_ml * heating_value_ * get_heater_efficiency(level);
+  if (energy_fraction_wh_ >= 1.0f) {
+    uint32_t whole_wh = static_cast<uint32_t>(energy_fraction_wh_);
+    daily_energy_wh_ += whole_wh;
+    total_energy_wh_ += whole_wh;
+    energy_fraction_wh_ -= whole_wh;
   }
 }
 
-void VevorHeater::reset_total_consumption() {
-  ESP_LOGI(TAG, "Manual reset of total consumption counter");
-  total_fuel_pulses_ = 0.0f;
-  total_consumption_ml_ = 0.0f;
-  save_fuel_consumption_data();
-  
+void VevorHeater::publish_energy_state() {
+  if (daily_energy_sensor_) {
+    daily_energy_sensor_->publish_state(get_daily_energy());
+  }
+  if (total_energy_sensor_) {
+    total_energy_sensor_->publish_state(get_total_energy());
+  }
+}
+
+void VevorHeater::save_pump_calibration_data() {
+  PumpCalibrationData data;
+  std::copy(std::begin(calibration_factor_), std::end(calibration_factor_), data.factor);
+  std::copy(std::begin(calibration_normal_matrix_), std::end(calibration_normal_matrix_), data.normal_matrix);
+  std::copy(std::begin(calibration_normal_vector_), std::end(calibration_normal_vector_), data.normal_vector);
+  std::copy(std::begin(refill_pulses_), std::end(refill_pulses_), data.refill_pulses);
+  data.refill_events = refill_events_;
+  
+  if (!pref_pump_calibration_.save(&data)) {
+    ESP_LOGW(TAG, "Failed to save pump calibration data");
+  }
+}
+
+void VevorHeater::load_pump_calibration_data() {
+  PumpCalibrationData data;
+  if (pref_pump_calibration_.load(&data)) {
+    bool valid = true;
+    for (float factor : data.factor) {
+      if (std::isnan(factor) || factor < CALIBRATION_MIN_FACTOR || factor > CALIBRATION_MAX_FACTOR) {
+        valid = false;
+      }
+    }
+    
+    if (valid) {
+      std::copy(std::begin(data.factor), std::end(data.factor), calibration_factor_);
+      std::copy(std::begin(data.normal_matrix), std::end(data.normal_matrix), calibration_normal_matrix_);
+      std::copy(std::begin(data.normal_vector), std::end(data.normal_vector), calibration_normal_vector_);
+      std::copy(std::begin(data.refill_pulses), std::end(data.refill_pulses), refill_pulses_);
+      refill_events_ = data.refill_events;
+      ESP_LOGI(TAG, "Loaded pump calibration from %d refills", refill_events_);
+    } else {
+      ESP_LOGW(TAG, "Stored pump calibration is invalid, using injected_per_pulse only");
+    }
+  } else {
+    ESP_LOGI(TAG, "No pump calibration found, using injected_per_pulse only");
+  }
+  
+  fuel_since_refill_ml_ = compute_fuel_since_refill();
+  if (fuel_since_refill_sensor_) {
+    fuel_since_refill_sensor_->publish_state(fuel_since_refill_ml_);
+  }
+}
+
+float VevorHeater::compute_fuel_since_refill() const {
+  float total = 0.0f;
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    total += refill_pulses_[i] * calibration_factor_[i] * injected_per_pulse_;
+  }
+  return total;
+}
+
+void VevorHeater::log_refill(float volume_ml) {
+  if (volume_ml <= 0.0f) {
+    ESP_LOGW(TAG, "Refill volume must be positive, enter the measured volume first");
+    return;
+  }
+  
+  // Uncalibrated prediction of the refilled volume, one regression row per refill
+  float row[CALIBRATION_BINS];
+  float base_predicted_ml = 0.0f;
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    row[i] = refill_pulses_[i] * injected_per_pulse_;
+    base_predicted_ml += row[i];
+  }
+  
+  ESP_LOGI(TAG, "Refill logged: %.0f ml measured, %.0f ml estimated", volume_ml, fuel_since_refill_ml_);
+  
+  float ratio = base_predicted_ml > 0.0f ? volume_ml / base_predicted_ml : 0.0f;
+  if (base_predicted_ml < 100.0f) {
+    ESP_LOGW(TAG, "Too little fuel used since last refill (%.0f ml) to calibrate", base_predicted_ml);
+  } else if (ratio < CALIBRATION_MIN_FACTOR / 1.5f || ratio > CALIBRATION_MAX_FACTOR * 1.5f) {
+    ESP_LOGW(TAG, "Refill volume deviates %.1fx from estimate, ignoring for calibration", ratio);
+  } else {
+    // Age previous refills so pump wear is tracked, then accumulate the normal equations
+    for (auto &value : calibration_normal_matrix_) {
+      value *= CALIBRATION_FORGETTING;
+    }
+    for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+      calibration_normal_vector_[i] = calibration_normal_vector_[i] * CALIBRATION_FORGETTING + row[i] * volume_ml;
+      for (uint8_t j = i; j < CALIBRATION_BINS; j++) {
+        calibration_normal_matrix_[calibration_tri_index(i, j)] += row[i] * row[j];
+      }
+    }
+    refill_events_++;
+    
+    if (solve_pump_calibration()) {
+      for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+        ESP_LOGI(TAG, "  Power %3d%%: %.4f ml/pulse (factor %.3f)", (i + 1) * 10,
+                 injected_per_pulse_ * calibration_factor_[i], calibration_factor_[i]);
+      }
+    }
+  }
+  
+  // Tank is refilled, start accumulating pulses for the next refill
+  for (auto &pulses : refill_pulses_) {
+    pulses = 0.0f;
+  }
+  fuel_since_refill_ml_ = 0.0f;
+  if (fuel_since_refill_sensor_) {
+    fuel_since_refill_sensor_->publish_state(fuel_since_refill_ml_);
+  }
+  
+  calibration_dirty_ = true;
+  mark_fuel_data_dirty(true);
+  
+  // A logged refill means the tank was filled up
+  if (has_tank()) {
+    refill_tank();
+  }
+}
+
+bool VevorHeater::solve_pump_calibration() {
+  // Ridge regression towards factor 1.0: (A^T A + lambda I) x = A^T b + lambda.
+  // Power levels that never ran get no data and simply stay at the prior.
+  double m[CALIBRATION_BINS][CALIBRATION_BINS];
+  double x[CALIBRATION_BINS];
+  double max_diag = 0.0;
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    for (uint8_t j = 0; j < CALIBRATION_BINS; j++) {
+      m[i][j] = calibration_normal_matrix_[calibration_tri_index(i, j)];
+    }
+    max_diag = std::max(max_diag, m[i][i]);
+  }
+  if (max_diag <= 0.0) {
+    return false;
+  }
+  
+  double lambda = max_diag * 0.01;
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    m[i][i] += lambda;
+    x[i] = calibration_normal_vector_[i] + lambda;
+  }
+  
+  // Cholesky decomposition in place (lower triangle), matrix is SPD thanks to the ridge term
+  for (uint8_t j = 0; j < CALIBRATION_BINS; j++) {
+    double diag = m[j][j];
+    for (uint8_t k = 0; k < j; k++) {
+      diag -= m[j][k] * m[j][k];
+    }
+    if (diag <= 0.0) {
+      ESP_LOGW(TAG, "Pump calibration fit is ill-conditioned, keeping previous factors");
+      return false;
+    }
+    m[j][j] = std::sqrt(diag);
+    for (uint8_t i = j + 1; i < CALIBRATION_BINS; i++) {
+      double value = m[i][j];
+      for (uint8_t k = 0; k < j; k++) {
+        value -= m[i][k] * m[j][k];
+      }
+      m[i][j] = value / m[j][j];
+    }
+  }
+  
+  // Forward and back substitution
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    for (uint8_t k = 0; k < i; k++) {
+      x[i] -= m[i][k] * x[k];
+    }
+    x[i] /= m[i][i];
+  }
+  for (int i = CALIBRATION_BINS - 1; i >= 0; i--) {
+    for (int k = i + 1; k < CALIBRATION_BINS; k++) {
+      x[i] -= m[k][i] * x[k];
+    }
+    x[i] /= m[i][i];
+  }
+  
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    calibration_factor_[i] = std::max(CALIBRATION_MIN_FACTOR, std::min(CALIBRATION_MAX_FACTOR, static_cast<float>(x[i])));
+  }
+  return true;
+}
+
+void VevorHeater::reset_pump_calibration() {
+  ESP_LOGI(TAG, "Resetting learned pump calibration");
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    calibration_factor_[i] = 1.0f;
+    calibration_normal_vector_[i] = 0.0f;
+  }
+  for (auto &value : calibration_normal_matrix_) {
+    value = 0.0f;
+  }
+  refill_events_ = 0;
+  fuel_since_refill_ml_ = compute_fuel_since_refill();
+  
+  calibration_dirty_ = true;
+  mark_fuel_data_dirty(true);
+}
+
+void VevorHeater::reset_daily_consumption() {
+  ESP_LOGI(TAG, "Manual reset of daily consumption counter");
+  daily_consumption_ml_ = 0.0f;
+  daily_energy_wh_ = 0;
+  mark_fuel_data_dirty(true);
+  
+  if (daily_consumption_sensor_) {
+    daily_consumption_sensor_->publish_state(daily_consumption_ml_);
+  }
+  publish_energy_state();
+}
+
+void VevorHeater::reset_total_consumption() {
+  ESP_LOGI(TAG, "Manual reset of total consumption counter");
+  total_fuel_pulses_ = 0.0f;
+  total_consumption_ml_ = 0.0f;
+  total_energy_wh_ = 0;
+  mark_fuel_data_dirty(true);
+  
   if (total_consumption_sensor_) {
     total_consumption_sensor_->publish_state(total_consumption_ml_);
   }
+  publish_energy_state();
 }
 
 void VevorHeater::check_voltage_safety() {
+  // No reading before the first frame, a restored lockout must not log a low voltage fault
+  if (!frame_received_) {
+    return;
+  }
   bool voltage_error = false;
   
   // Check voltage thresholds based on state
-  if ((current_state_ == HeaterState::OFF || current_state_ == HeaterState::POLLING_STATE) && 
-      heater_enabled_) {
+  if (controller_.is_locked_out()) {
+    // Locked out until the supply can start the heater again, not just keep it running.
+    // A latched lockout is the restart limit, only a reset clears it.
+    voltage_error = input_voltage_ < min_voltage_start_;
+    if (!voltage_error && !controller_.is_latched()) {
+      ESP_LOGI(TAG, "Voltage recovered: %.1fV", input_voltage_);
+      controller_.dispatch(ControllerEvent::VOLTAGE_OK);
+    }
+  } else if ((current_state_ == HeaterState::OFF || current_state_ == HeaterState::POLLING_STATE) && 
+             controller_.is_heat_requested()) {
     // During OFF/POLLING_STATE, check if voltage is sufficient to start
     if (input_voltage_ < min_voltage_start_) {
       ESP_LOGW(TAG, "Low voltage detected during start: %.1fV < %.1fV", 
                input_voltage_, min_voltage_start_);
       voltage_error = true;
-      heater_enabled_ = false;  // Prevent starting
+      controller_.dispatch(ControllerEvent::LOW_VOLTAGE);  // Prevent starting
     }
   } else if (current_state_ == HeaterState::STABLE_COMBUSTION) {
     // During stable combustion, check if voltage is sufficient to keep running
@@ -553,10 +1320,14 @@ void VevorHeater::check_voltage_safety() {
       ESP_LOGW(TAG, "Low voltage detected during operation: %.1fV < %.1fV - Stopping heater", 
                input_voltage_, min_voltage_operate_);
       voltage_error = true;
-      heater_enabled_ = false;  // Force stop
+      controller_.dispatch(ControllerEvent::LOW_VOLTAGE);  // Force stop
     }
   }
   
+  if (voltage_error && !low_voltage_error_) {
+    record_fault(FaultCode::LOW_VOLTAGE, nullptr);
+  }
+  
   // Update error state
   if (voltage_error != low_voltage_error_) {
     low_voltage_error_ = voltage_error;
@@ -586,7 +1357,7 @@ void VevorHeater::handle_antifreeze_mode() {
   }
   
   float temp = external_temperature_;
-  float current_power = heater_enabled_ ? (power_level_ * 10.0f) : 0.0f;
+  float current_power = controller_.is_heat_requested() ? (power_level_ * 10.0f) : 0.0f;
   
   // Simple antifreeze logic:
   // ON/OFF: No hysteresis
@@ -602,7 +1373,7 @@ void VevorHeater::handle_antifreeze_mode() {
   
   // Turn OFF if temp >= OFF threshold
   if (temp >= antifreeze_temp_off_) {
-    if (heater_enabled_) {
+    if (controller_.is_heat_requested()) {
       ESP_LOGI(TAG, "Antifreeze: Temperature %.1f°C >= %.1f°C, turning off", temp, antifreeze_temp_off_);
       turn_off();
       antifreeze_active_ = false;
@@ -613,11 +1384,14 @@ void VevorHeater::handle_antifreeze_mode() {
   
   // Turn ON at 80% if temp < ON threshold
   if (temp < antifreeze_temp_on_) {
-    if (!heater_enabled_) {
+    if (!controller_.is_heat_requested()) {
+      if (is_start_deferred()) {
+        return;  // Wait for lockout, backoff or cooldown to clear instead of retrying every poll
+      }
       ESP_LOGI(TAG, "Antifreeze: Temperature %.1f°C < %.1f°C, turning on at 80%%", temp, antifreeze_temp_on_);
       set_power_level_percent(80.0f);
       turn_on();
-      antifreeze_active_ = true;
+      antifreeze_active_ = controller_.is_heat_requested();
       last_antifreeze_power_ = 80.0f;
     } else if (current_power != 80.0f) {
       ESP_LOGI(TAG, "Antifreeze: Temperature %.1f°C, setting to 80%%", temp);
@@ -628,7 +1402,7 @@ void VevorHeater::handle_antifreeze_mode() {
   }
   
   // If heater is OFF and temp >= ON threshold, stay OFF (don't auto-start)
-  if (!heater_enabled_) {
+  if (!controller_.is_heat_requested()) {
     return;
   }
   
@@ -674,13 +1448,471 @@ void VevorHeater::handle_antifreeze_mode() {
   }
 }
 
+void VevorHeater::add_schedule_slot(uint8_t days, uint16_t start_minute, uint16_t end_minute, uint8_t power_percent,
+                                    float target_temperature, uint8_t preheat_minutes) {
+  for (auto &slot : schedule_slots_) {
+    if (slot.days == 0) {
+      slot.days = days;
+      slot.start_minute = start_minute % MINUTES_PER_DAY;
+      slot.end_minute = end_minute % MINUTES_PER_DAY;
+      slot.power_percent = power_percent;
+      slot.target_temperature_x10 = std::isnan(target_temperature)
+                                        ? SCHEDULE_NO_TARGET
+                                        : static_cast<int16_t>(lroundf(target_temperature * 10.0f));
+      slot.preheat_minutes = preheat_minutes;
+      return;
+    }
+  }
+  ESP_LOGW(TAG, "Schedule full, ignoring slot (max %d)", MAX_SCHEDULE_SLOTS);
+}
+
+bool VevorHeater::set_schedule_slot(uint8_t index, uint8_t days, uint16_t start_minute, uint16_t end_minute,
+                                    uint8_t power_percent, float target_temperature, uint8_t preheat_minutes) {
+  if (index >= MAX_SCHEDULE_SLOTS || start_minute >= MINUTES_PER_DAY || end_minute >= MINUTES_PER_DAY ||
+      (days & 0x7F) == 0 || power_percent > 100) {
+    ESP_LOGW(TAG, "Invalid schedule slot %d", index);
+    return false;
+  }
+  
+  ScheduleSlot &slot = schedule_slots_[index];
+  slot.days = days & 0x7F;
+  slot.start_minute = start_minute;
+  slot.end_minute = end_minute;
+  slot.power_percent = power_percent;
+  slot.target_temperature_x10 = std::isnan(target_temperature)
+                                    ? SCHEDULE_NO_TARGET
+                                    : static_cast<int16_t>(lroundf(target_temperature * 10.0f));
+  slot.preheat_minutes = preheat_minutes;
+  ESP_LOGI(TAG, "Schedule slot %d set: days 0x%02X, %02d:%02d-%02d:%02d", index, slot.days,
+           start_minute / 60, start_minute % 60, end_minute / 60, end_minute % 60);
+  
+  rebuild_schedule_index();
+  schedule_dirty_ = true;
+  mark_fuel_data_dirty(true);
+  return true;
+}
+
+bool VevorHeater::clear_schedule_slot(uint8_t index) {
+  if (index >= MAX_SCHEDULE_SLOTS) {
+    return false;
+  }
+  // Slot no longer exists, so its end event will never fire
+  end_schedule_slot(index);
+  schedule_slots_[index] = ScheduleSlot{};
+  ESP_LOGI(TAG, "Schedule slot %d cleared", index);
+  
+  rebuild_schedule_index();
+  schedule_dirty_ = true;
+  mark_fuel_data_dirty(true);
+  return true;
+}
+
+void VevorHeater::set_schedule_enabled(bool enabled) {
+  if (enabled == schedule_enabled_) {
+    return;
+  }
+  schedule_enabled_ = enabled;
+  ESP_LOGI(TAG, "Schedule %s", enabled ? "enabled" : "disabled");
+  if (!enabled) {
+    // No more events will fire, stop what the running slot started
+    end_schedule_slot(schedule_active_slot_);
+    end_schedule_slot(schedule_pending_slot_);
+  }
+  
+  // Re-evaluate on the next update so an enable inside a slot starts it
+  schedule_last_minute_ = SCHEDULE_MINUTE_INVALID;
+  schedule_dirty_ = true;
+  mark_fuel_data_dirty(true);
+}
+
+void VevorHeater::rebuild_schedule_index() {
+  // Expand every slot and day into start/stop events, then sort by minute of week.
+  // Done only on edits so update() just compares against the next event.
+  schedule_event_count_ = 0;
+  for (uint8_t i = 0; i < MAX_SCHEDULE_SLOTS; i++) {
+    const ScheduleSlot &slot = schedule_slots_[i];
+    if (slot.days == 0) {
+      continue;
+    }
+    for (uint8_t day = 0; day < 7; day++) {
+      if (!(slot.days & (1 << day))) {
+        continue;
+      }
+      uint16_t day_start = day * MINUTES_PER_DAY;
+      uint16_t end_offset = slot.end_minute > slot.start_minute ? slot.end_minute : slot.end_minute + MINUTES_PER_DAY;
+      // Auto preheat slots get their event when the earliest possible preheat window opens
+      uint8_t lead = slot.preheat_minutes == SCHEDULE_PREHEAT_AUTO ? MAX_AUTO_PREHEAT_MINUTES : slot.preheat_minutes;
+      int32_t start = static_cast<int32_t>(day_start) + slot.start_minute - lead;
+      int32_t end = static_cast<int32_t>(day_start) + end_offset;
+      schedule_events_[schedule_event_count_++] = {
+          static_cast<uint16_t>((start + MINUTES_PER_WEEK) % MINUTES_PER_WEEK), i, true};
+      schedule_events_[schedule_event_count_++] = {static_cast<uint16_t>(end % MINUTES_PER_WEEK), i, false};
+    }
+  }
+  
+  // Stops sort before starts on the same minute so back-to-back slots hand over cleanly
+  std::sort(schedule_events_, schedule_events_ + schedule_event_count_,
+            [](const ScheduleEvent &a, const ScheduleEvent &b) {
+              if (a.week_minute != b.week_minute) {
+                return a.week_minute < b.week_minute;
+              }
+              return !a.start && b.start;
+            });
+  
+  schedule_next_event_ = 0;
+  schedule_last_minute_ = SCHEDULE_MINUTE_INVALID;  // Re-seek on the next update
+  ESP_LOGD(TAG, "Schedule index rebuilt: %d events", schedule_event_count_);
+}
+
+void VevorHeater::seek_schedule(uint16_t week_minute, bool resume) {
+  // Binary search for the first event after now; only needed after boot, edits or clock jumps
+  const ScheduleEvent *begin = schedule_events_;
+  const ScheduleEvent *end = schedule_events_ + schedule_event_count_;
+  const ScheduleEvent *next = std::upper_bound(
+      begin, end, week_minute, [](uint16_t minute, const ScheduleEvent &event) { return minute < event.week_minute; });
+  schedule_next_event_ = (next == end) ? 0 : next - begin;
+  
+  if (!resume) {
+    return;
+  }
+  
+  // The most recent event (cyclically) tells whether we are inside a slot right now
+  uint8_t previous = schedule_next_event_ == 0 ? schedule_event_count_ - 1 : schedule_next_event_ - 1;
+  const ScheduleEvent &event = schedule_events_[previous];
+  if (event.start && schedule_active_slot_ != event.slot) {
+    ESP_LOGI(TAG, "Schedule: resuming slot %d", event.slot);
+    fire_schedule_event(event);
+  } else if (!event.start && schedule_active_slot_ == event.slot) {
+    fire_schedule_event(event);
+  }
+}
+
+void VevorHeater::handle_schedule() {
+#ifdef USE_TIME
+  if (!schedule_enabled_ || schedule_event_count_ == 0 || time_component_ == nullptr) {
+    return;
+  }
+  auto now = time_component_->now();
+  if (!now.is_valid()) {
+    return;
+  }
+  
+  uint16_t week_minute = (now.day_of_week - 1) * MINUTES_PER_DAY + now.hour * 60 + now.minute;
+  if (week_minute == schedule_last_minute_) {
+    return;
+  }
+  
+  uint16_t expected = (schedule_last_minute_ + 1) % MINUTES_PER_WEEK;
+  bool next_changed = false;
+  if (schedule_last_minute_ == SCHEDULE_MINUTE_INVALID || week_minute != expected) {
+    // Boot, edit, time sync or DST change - locate our position again
+    seek_schedule(week_minute, true);
+    next_changed = true;
+  } else {
+    // Normal minute tick: fire the events due now, bounded by the event count
+    for (uint8_t fired = 0; fired < schedule_event_count_; fired++) {
+      const ScheduleEvent &event = schedule_events_[schedule_next_event_];
+      if (event.week_minute != week_minute) {
+        break;
+      }
+      fire_schedule_event(event);
+      schedule_next_event_ = (schedule_next_event_ + 1) % schedule_event_count_;
+      next_changed = true;
+    }
+  }
+  
+  if (next_changed) {
+    publish_schedule_next_event();
+  }
+  handle_pending_preheat(week_minute);
+  schedule_last_minute_ = week_minute;
+#endif
+}
+
+void VevorHeater::fire_schedule_event(const ScheduleEvent &event) {
+  const ScheduleSlot &slot = schedule_slots_[event.slot];
+  
+  // Antifreeze owns the heater; the schedule resumes once the mode is changed back
+  if (control_mode_ == ControlMode::ANTIFREEZE) {
+    ESP_LOGD(TAG, "Schedule: slot %d %s skipped in antifreeze mode", event.slot, event.start ? "start" : "stop");
+    return;
+  }
+  
+  if (event.start) {
+    if (slot.preheat_minutes == SCHEDULE_PREHEAT_AUTO) {
+      // Preheat window opened - the predictor decides the actual start minute
+      ESP_LOGD(TAG, "Schedule: slot %d waiting for predicted preheat start", event.slot);
+      schedule_pending_slot_ = event.slot;
+      schedule_pending_window_ = event.week_minute;
+      return;
+    }
+    start_schedule_slot(event.slot);
+  } else if (schedule_pending_slot_ == event.slot) {
+    // Slot ended before the predicted start was reached
+    schedule_pending_slot_ = SCHEDULE_SLOT_NONE;
+  } else if (schedule_active_slot_ == event.slot) {
+    // Only stop a heater this slot started - a manual start is left alone
+    ESP_LOGI(TAG, "Schedule: slot %d ending", event.slot);
+    schedule_active_slot_ = SCHEDULE_SLOT_NONE;
+    if (controller_.is_heat_requested()) {
+      turn_off();
+    }
+  }
+}
+
+void VevorHeater::end_schedule_slot(uint8_t index) {
+  if (index == SCHEDULE_SLOT_NONE || (schedule_active_slot_ != index && schedule_pending_slot_ != index)) {
+    return;
+  }
+  fire_schedule_event(ScheduleEvent{0, index, false});
+  // Skipped in antifreeze mode, the slot still no longer owns the heater
+  if (schedule_active_slot_ == index) {
+    schedule_active_slot_ = SCHEDULE_SLOT_NONE;
+  }
+  if (schedule_pending_slot_ == index) {
+    schedule_pending_slot_ = SCHEDULE_SLOT_NONE;
+  }
+}
+
+void VevorHeater::start_schedule_slot(uint8_t index) {
+  const ScheduleSlot &slot = schedule_slots_[index];
+  ESP_LOGI(TAG, "Schedule: slot %d starting", index);
+  if (slot.target_temperature_x10 != SCHEDULE_NO_TARGET) {
+    set_target_temperature(slot.target_temperature_x10 / 10.0f);
+  }
+  if (!controller_.is_heat_requested()) {
+    turn_on();
+  }
+  if (slot.power_percent > 0) {
+    set_power_level_percent(slot.power_percent);
+  }
+  if (controller_.is_heat_requested()) {
+    schedule_active_slot_ = index;
+  }
+}
+
+void VevorHeater::handle_pending_preheat(uint16_t week_minute) {
+  if (schedule_pending_slot_ == SCHEDULE_SLOT_NONE) {
+    return;
+  }
+  if (control_mode_ == ControlMode::ANTIFREEZE) {
+    schedule_pending_slot_ = SCHEDULE_SLOT_NONE;
+    return;
+  }
+  
+  const ScheduleSlot &slot = schedule_slots_[schedule_pending_slot_];
+  int32_t since_window = (week_minute - schedule_pending_window_ + MINUTES_PER_WEEK) % MINUTES_PER_WEEK;
+  int32_t minutes_to_start = static_cast<int32_t>(MAX_AUTO_PREHEAT_MINUTES) - since_window;
+  
+  float target = slot.target_temperature_x10 != SCHEDULE_NO_TARGET ? slot.target_temperature_x10 / 10.0f
+                                                                    : target_temperature_;
+  uint8_t level = slot.power_percent > 0 ? slot.power_percent / 10 : static_cast<uint8_t>(default_power_percent_ / 10.0f);
+  float lead = predict_preheat_minutes(target, external_temperature_, level);
+  if (std::isnan(lead)) {
+    lead = DEFAULT_AUTO_PREHEAT_MINUTES;
+  }
+  
+  if (minutes_to_start <= lead) {
+    ESP_LOGI(TAG, "Schedule: predicted preheat %.0f min, starting %d min before slot %d", lead,
+             std::max<int32_t>(0, minutes_to_start), schedule_pending_slot_);
+    uint8_t index = schedule_pending_slot_;
+    schedule_pending_slot_ = SCHEDULE_SLOT_NONE;
+    start_schedule_slot(index);
+  }
+}
+
+void VevorHeater::update_warmup_learning() {
+  uint32_t now = millis();
+  
+  // Measure ignition time from the moment the heater is enabled while OFF
+  bool heater_enabled = controller_.is_heat_requested();
+  if (heater_enabled && !warmup_was_enabled_) {
+    warmup_enabled_at_ = now;
+    warmup_startup_measured_ = current_state_ != HeaterState::OFF;  // Already running, nothing to measure
+  }
+  warmup_was_enabled_ = heater_enabled;
+  
+  if (!warmup_session_active_) {
+    if (current_state_ != HeaterState::STABLE_COMBUSTION || !heater_enabled) {
+      return;
+    }
+    if (!warmup_startup_measured_) {
+      float startup = (now - warmup_enabled_at_) / 60000.0f;
+      if (startup > 0.5f && startup < 30.0f) {
+        startup_minutes_ += 0.3f * (startup - startup_minutes_);
+        warmup_dirty_ = true;
+        ESP_LOGD(TAG, "Warm-up: ignition took %.1f min (avg %.1f)", startup, startup_minutes_);
+      }
+      warmup_startup_measured_ = true;
+      
+      // Only sessions that start right after ignition reflect a cold start
+      if (has_external_sensor()) {
+        warmup_session_active_ = true;
+        warmup_session_start_ = now;
+        warmup_start_temp_ = external_temperature_;
+        warmup_level_ = get_fuel_power_level();
+      }
+    }
+    return;
+  }
+  
+  // A session ends on shutdown, power change, lost sensor, reaching target or timeout
+  uint32_t elapsed = now - warmup_session_start_;
+  if (current_state_ != HeaterState::STABLE_COMBUSTION || !heater_enabled || !has_external_sensor() ||
+      get_fuel_power_level() != warmup_level_ || external_temperature_ >= target_temperature_ ||
+      elapsed >= WARMUP_MAX_DURATION_MS) {
+    finish_warmup_session();
+  }
+}
+
+void VevorHeater::finish_warmup_session() {
+  warmup_session_active_ = false;
+  
+  uint32_t elapsed = millis() - warmup_session_start_;
+  float rise = external_temperature_ - warmup_start_temp_;
+  if (elapsed < WARMUP_MIN_DURATION_MS || std::isnan(rise) || rise < WARMUP_MIN_RISE ||
+      warmup_level_ < 1 || warmup_level_ > 10) {
+    ESP_LOGV(TAG, "Warm-up session discarded");
+    return;
+  }
+  
+  float rate = rise / (elapsed / 60000.0f);
+  rate = std::max(WARMUP_MIN_RATE, std::min(WARMUP_MAX_RATE, rate));
+  
+  WarmupStats &stats = warmup_stats_[warmup_level_ - 1];
+  stats.n = stats.n * WARMUP_FORGETTING + 1.0f;
+  stats.sum_x = stats.sum_x * WARMUP_FORGETTING + warmup_start_temp_;
+  stats.sum_y = stats.sum_y * WARMUP_FORGETTING + rate;
+  stats.sum_xx = stats.sum_xx * WARMUP_FORGETTING + warmup_start_temp_ * warmup_start_temp_;
+  stats.sum_xy = stats.sum_xy * WARMUP_FORGETTING + warmup_start_temp_ * rate;
+  warmup_dirty_ = true;
+  mark_fuel_data_dirty(true);
+  
+  ESP_LOGI(TAG, "Warm-up learned: %.2f °C/min from %.1f °C at %d%% power", rate, warmup_start_temp_,
+           warmup_level_ * 10);
+}
+
+float VevorHeater::predict_warmup_rate(float start_temp, uint8_t level) const {
+  if (std::isnan(start_temp) || level < 1 || level > 10) {
+    return NAN;
+  }
+  
+  // Use the requested level, otherwise the nearest level that has data
+  const WarmupStats *stats = nullptr;
+  for (int distance = 0; distance < 10 && stats == nullptr; distance++) {
+    for (int candidate : {level - distance, level + distance}) {
+      if (candidate >= 1 && candidate <= 10 && warmup_stats_[candidate - 1].n >= 0.5f) {
+        stats = &warmup_stats_[candidate - 1];
+        break;
+      }
+    }
+  }
+  if (stats == nullptr) {
+    return NAN;
+  }
+  
+  float mean_x = stats->sum_x / stats->n;
+  float mean_y = stats->sum_y / stats->n;
+  float var_x = stats->sum_xx / stats->n - mean_x * mean_x;
+  float rate = mean_y;
+  // Need at least a couple of samples spread over 2 °C before trusting the slope
+  if (stats->n >= 2.0f && var_x > 1.0f) {
+    float slope = (stats->sum_xy / stats->n - mean_x * mean_y) / var_x;
+    rate = mean_y + slope * (start_temp - mean_x);
+  }
+  return std::max(WARMUP_MIN_RATE, std::min(WARMUP_MAX_RATE, rate));
+}
+
+float VevorHeater::predict_preheat_minutes(float target, float start_temp, uint8_t level) const {
+  if (std::isnan(target) || std::isnan(start_temp)) {
+    return NAN;
+  }
+  if (start_temp >= target) {
+    return 0.0f;
+  }
+  float rate = predict_warmup_rate(start_temp, level);
+  if (std::isnan(rate)) {
+    return NAN;
+  }
+  float minutes = startup_minutes_ + (target - start_temp) / rate;
+  return std::min(minutes, static_cast<float>(MAX_AUTO_PREHEAT_MINUTES));
+}
+
+void VevorHeater::save_warmup_model() {
+  WarmupModelData data;
+  std::copy(std::begin(warmup_stats_), std::end(warmup_stats_), data.stats);
+  data.startup_minutes = startup_minutes_;
+  
+  if (!pref_warmup_model_.save(&data)) {
+    ESP_LOGW(TAG, "Failed to save warm-up model");
+  }
+}
+
+void VevorHeater::load_warmup_model() {
+  WarmupModelData data;
+  if (pref_warmup_model_.load(&data) && !std::isnan(data.startup_minutes)) {
+    std::copy(std::begin(data.stats), std::end(data.stats), warmup_stats_);
+    startup_minutes_ = data.startup_minutes;
+    ESP_LOGI(TAG, "Loaded warm-up model, ignition %.1f min", startup_minutes_);
+  }
+}
+
+void VevorHeater::publish_schedule_next_event() {
+  if (schedule_next_event_sensor_ == nullptr) {
+    return;
+  }
+  if (!schedule_enabled_ || schedule_event_count_ == 0) {
+    schedule_next_event_sensor_->publish_state("None");
+    return;
+  }
+  
+  static const char *const DAYS[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+  const ScheduleEvent &event = schedule_events_[schedule_next_event_];
+  uint16_t minute_of_day = event.week_minute % MINUTES_PER_DAY;
+  char buffer[32];
+  snprintf(buffer, sizeof(buffer), "%s %02d:%02d %s", DAYS[event.week_minute / MINUTES_PER_DAY],
+           minute_of_day / 60, minute_of_day % 60, event.start ? "On" : "Off");
+  schedule_next_event_sensor_->publish_state(buffer);
+}
+
+void VevorHeater::save_schedule_data() {
+  ScheduleData data;
+  data.config_hash = schedule_config_hash_;
+  data.enabled = schedule_enabled_;
+  std::copy(std::begin(schedule_slots_), std::end(schedule_slots_), data.slots);
+  
+  if (!pref_schedule_.save(&data)) {
+    ESP_LOGW(TAG, "Failed to save schedule");
+  }
+}
+
+void VevorHeater::load_schedule_data() {
+  ScheduleData data;
+  if (pref_schedule_.load(&data) && data.config_hash == schedule_config_hash_) {
+    schedule_enabled_ = data.enabled;
+    std::copy(std::begin(data.slots), std::end(data.slots), schedule_slots_);
+    ESP_LOGI(TAG, "Loaded schedule from flash");
+  } else if (schedule_config_hash_ != 0) {
+    // First boot or the YAML schedule changed - YAML slots become the new baseline
+    save_schedule_data();
+  }
+  
+  rebuild_schedule_index();
+  publish_schedule_next_event();
+}
+
 void VevorHeater::handle_communication_timeout() {
-  static uint32_t last_timeout_log = 0;
   uint32_t now = millis();
   
-  if (now - last_timeout_log > 10000) {  // Log every 10 seconds
-    ESP_LOGW(TAG, "Communication timeout - heater not responding");
-    last_timeout_log = now;
+  if (now - last_timeout_log_ > 10000) {  // Log every 10 seconds
+    ESP_LOGW(TAG, "Communication timeout - heater 0x%02X not responding", device_id_);
+    last_timeout_log_ = now;
+  }
+  
+  // One fault per outage, cleared by the next valid frame
+  if (!communication_fault_active_) {
+    communication_fault_active_ = true;
+    record_fault(FaultCode::COMMUNICATION_LOST, nullptr);
   }
   
   // Reset sensors to unknown state
@@ -689,6 +1921,300 @@ void VevorHeater::handle_communication_timeout() {
   }
 }
 
+void VevorHeater::check_state_faults(HeaterState old_state, HeaterState new_state, const std::vector<uint8_t> &frame) {
+  // Only transitions we did not ask for are faults - a commanded stop leaves STARTING/RUNNING first
+  if (!controller_.is_heat_requested()) {
+    return;
+  }
+  bool stopping = new_state == HeaterState::STOPPING_COOLING || new_state == HeaterState::OFF;
+  
+  if ((old_state == HeaterState::HEATING_UP && stopping) ||
+      (old_state == HeaterState::POLLING_STATE && new_state == HeaterState::STOPPING_COOLING)) {
+    record_fault(FaultCode::IGNITION_FAILURE, &frame);
+  } else if (old_state == HeaterState::STABLE_COMBUSTION && (stopping || new_state == HeaterState::HEATING_UP)) {
+    record_fault(FaultCode::FLAME_OUT, &frame);
+  }
+}
+
+void VevorHeater::check_frame_faults(const std::vector<uint8_t> &frame) {
+  communication_fault_active_ = false;
+  
+  // Capture state bytes we cannot decode instead of just showing "Unknown"
+  uint8_t state_raw = frame[HEATER_PROFILE.status.state];
+  if (state_raw != last_state_raw_ && state_raw > static_cast<uint8_t>(HeaterState::STOPPING_COOLING)) {
+    record_fault(FaultCode::UNKNOWN_STATE, &frame);
+  }
+  last_state_raw_ = state_raw;
+  
+  // Overheat is edge triggered with 20 °C hysteresis
+  float heat_exchanger = static_cast<int16_t>(read_uint16_be(frame, HEATER_PROFILE.status.heat_exchanger)) / 10.0f;
+  if (!overheat_active_ && heat_exchanger >= overheat_temperature_) {
+    overheat_active_ = true;
+    record_fault(FaultCode::OVERHEAT, &frame);
+  } else if (overheat_active_ && heat_exchanger < overheat_temperature_ - 20.0f) {
+    overheat_active_ = false;
+  }
+  
+  // Combustion reported but no fuel delivered
+  if (current_state_ == HeaterState::STABLE_COMBUSTION && frame[HEATER_PROFILE.status.pump_frequency] == 0) {
+    if (pump_fault_frames_ < PUMP_FAULT_FRAMES && ++pump_fault_frames_ == PUMP_FAULT_FRAMES) {
+      record_fault(FaultCode::PUMP_FAULT, &frame);
+    }
+  } else {
+    pump_fault_frames_ = 0;
+  }
+}
+
+void VevorHeater::record_fault(FaultCode code, const std::vector<uint8_t> *frame) {
+  FaultLogEntry &entry = fault_log_[fault_log_head_];
+  entry = FaultLogEntry{};
+  entry.code = static_cast<uint8_t>(code);
+  entry.state_raw = frame != nullptr ? (*frame)[HEATER_PROFILE.status.state] : static_cast<uint8_t>(current_state_);
+  entry.voltage_x10 = static_cast<uint8_t>(std::min(255.0f, input_voltage_ * 10.0f));
+  entry.power_level = get_fuel_power_level();
+  entry.heat_exchanger_x10 = static_cast<int16_t>(heat_exchanger_temperature_ * 10.0f);
+  entry.external_x10 = std::isnan(external_temperature_) ? INT16_MIN : static_cast<int16_t>(external_temperature_ * 10.0f);
+  if (frame != nullptr) {
+    for (uint8_t i = 0; i < FAULT_RAW_BYTES; i++) {
+      entry.raw[i] = (*frame)[HEATER_PROFILE.status.undecoded[i]];
+    }
+  }
+  
+  entry.timestamp = get_unix_time();
+  
+  fault_log_head_ = (fault_log_head_ + 1) % FAULT_LOG_SIZE;
+  fault_log_size_ = std::min<uint8_t>(fault_log_size_ + 1, FAULT_LOG_SIZE);
+  if (fault_counts_[entry.code] < UINT16_MAX) {
+    fault_counts_[entry.code]++;
+  }
+  last_fault_ = code;
+  
+  ESP_LOGW(TAG, "Fault: %s (state 0x%02X, %.1fV, HX %.1f°C)", fault_to_string(code), entry.state_raw,
+           entry.voltage_x10 / 10.0f, entry.heat_exchanger_x10 / 10.0f);
+  if (frame != nullptr) {
+    ESP_LOGW(TAG, "Fault frame: %s", format_hex_pretty(*frame).c_str());
+  }
+  
+  publish_fault_state();
+  fault_log_dirty_ = true;
+  mark_fuel_data_dirty(true);
+}
+
+uint32_t VevorHeater::get_total_fault_count() const {
+  uint32_t total = 0;
+  for (uint8_t i = 1; i < FAULT_CODE_COUNT; i++) {
+    total += fault_counts_[i];
+  }
+  return total;
+}
+
+void VevorHeater::publish_fault_state() {
+  if (fault_count_sensor_) {
+    fault_count_sensor_->publish_state(get_total_fault_count());
+  }
+  if (last_fault_sensor_) {
+    last_fault_sensor_->publish_state(fault_to_string(last_fault_));
+  }
+  status_snapshot_.set(status_snapshot_.fault_count, static_cast<uint16_t>(get_total_fault_count()));
+  status_snapshot_.set(status_snapshot_.last_fault, fault_to_string(last_fault_));
+  status_snapshot_.set(status_snapshot_.last_fault_code, static_cast<uint8_t>(last_fault_));
+}
+
+void VevorHeater::clear_fault_log() {
+  ESP_LOGI(TAG, "Clearing fault log");
+  for (auto &entry : fault_log_) {
+    entry = FaultLogEntry{};
+  }
+  for (auto &count : fault_counts_) {
+    count = 0;
+  }
+  fault_log_head_ = 0;
+  fault_log_size_ = 0;
+  last_fault_ = FaultCode::NONE;
+  
+  publish_fault_state();
+  fault_log_dirty_ = true;
+  mark_fuel_data_dirty(true);
+}
+
+void VevorHeater::save_fault_log() {
+  FaultLogData data;
+  std::copy(std::begin(fault_log_), std::end(fault_log_), data.entries);
+  std::copy(std::begin(fault_counts_), std::end(fault_counts_), data.counts);
+  data.head = fault_log_head_;
+  data.size = fault_log_size_;
+  
+  if (!pref_fault_log_.save(&data)) {
+    ESP_LOGW(TAG, "Failed to save fault log");
+  }
+}
+
+void VevorHeater::load_fault_log() {
+  FaultLogData data;
+  if (pref_fault_log_.load(&data) && data.head < FAULT_LOG_SIZE && data.size <= FAULT_LOG_SIZE) {
+    std::copy(std::begin(data.entries), std::end(data.entries), fault_log_);
+    std::copy(std::begin(data.counts), std::end(data.counts), fault_counts_);
+    fault_log_head_ = data.head;
+    fault_log_size_ = data.size;
+    if (fault_log_size_ > 0) {
+      uint8_t newest = (fault_log_head_ + FAULT_LOG_SIZE - 1) % FAULT_LOG_SIZE;
+      last_fault_ = static_cast<FaultCode>(fault_log_[newest].code);
+    }
+    ESP_LOGI(TAG, "Loaded fault log: %d entries, %" PRIu32 " faults total", fault_log_size_, get_total_fault_count());
+  }
+  
+  publish_fault_state();
+}
+
+void VevorHeater::update_maintenance(HeaterState old_state) {
+  uint32_t now = millis();
+  uint32_t gap = now - last_maintenance_frame_;
+  last_maintenance_frame_ = now;
+  bool queue_save = false;
+  
+  // A new ignition is a run that reaches HEATING_UP from anything but combustion
+  bool was_burning = old_state == HeaterState::HEATING_UP || old_state == HeaterState::STABLE_COMBUSTION;
+  if (current_state_ == HeaterState::HEATING_UP && !was_burning) {
+    maintenance_.ignitions++;
+    queue_save = true;
+    ESP_LOGD(TAG, "Ignition %" PRIu32, maintenance_.ignitions);
+  }
+  
+  // The interval since the previous frame belongs to the state that frame reported.
+  // A long gap is a lost link or a reboot, its runtime is unknown and not counted.
+  bool fan_running = was_burning || old_state == HeaterState::STOPPING_COOLING;
+  if (fan_running && gap <= MAINTENANCE_MAX_FRAME_GAP_MS) {
+    maintenance_remainder_ms_ += gap;
+    uint32_t seconds = maintenance_remainder_ms_ / 1000;
+    maintenance_remainder_ms_ %= 1000;
+    if (seconds > 0) {
+      maintenance_.fan_seconds[get_fuel_power_level() - 1] += seconds;
+      if (was_burning) {
+        maintenance_.burner_seconds += seconds;
+      }
+      maintenance_unsaved_s_ += seconds;
+    }
+  } else {
+    maintenance_remainder_ms_ = 0;
+  }
+  
+  if (maintenance_unsaved_s_ >= MAINTENANCE_SAVE_INTERVAL_S) {
+    queue_save = true;
+  }
+  if (queue_save) {
+    maintenance_unsaved_s_ = 0;
+    maintenance_dirty_ = true;
+    mark_fuel_data_dirty();
+    publish_maintenance_state();
+  }
+}
+
+float VevorHeater::get_fan_hours() const {
+  uint32_t total = 0;
+  for (uint32_t seconds : maintenance_.fan_seconds) {
+    total += seconds;
+  }
+  return total / 3600.0f;
+}
+
+void VevorHeater::publish_maintenance_state() {
+  bool due = (service_interval_seconds_ > 0 &&
+              maintenance_.burner_seconds - maintenance_.service_burner_seconds >= service_interval_seconds_) ||
+             (service_interval_ignitions_ > 0 && get_ignitions_since_service() >= service_interval_ignitions_);
+  if (due != service_due_) {
+    service_due_ = due;
+    if (due) {
+      ESP_LOGW(TAG, "Service due: %.1f burner hours, %" PRIu32 " ignitions since last service",
+               get_burner_hours_since_service(), get_ignitions_since_service());
+    }
+  }
+  
+  if (burner_hours_sensor_) {
+    burner_hours_sensor_->publish_state(get_burner_hours());
+  }
+  if (fan_hours_sensor_) {
+    fan_hours_sensor_->publish_state(get_fan_hours());
+  }
+  if (ignition_count_sensor_) {
+    ignition_count_sensor_->publish_state(maintenance_.ignitions);
+  }
+  if (burner_hours_since_service_sensor_) {
+    burner_hours_since_service_sensor_->publish_state(get_burner_hours_since_service());
+  }
+  if (ignitions_since_service_sensor_) {
+    ignitions_since_service_sensor_->publish_state(get_ignitions_since_service());
+  }
+  if (service_due_sensor_) {
+    service_due_sensor_->publish_state(service_due_);
+  }
+}
+
+void VevorHeater::reset_service_counters() {
+  // Lifetime totals keep counting, only the since-service baseline moves
+  ESP_LOGI(TAG, "Service recorded at %.1f burner hours, %" PRIu32 " ignitions", get_burner_hours(),
+           maintenance_.ignitions);
+  maintenance_.service_burner_seconds = maintenance_.burner_seconds;
+  maintenance_.service_ignitions = maintenance_.ignitions;
+  maintenance_unsaved_s_ = 0;
+  publish_maintenance_state();
+  maintenance_dirty_ = true;
+  mark_fuel_data_dirty(true);
+}
+
+void VevorHeater::save_maintenance() {
+  if (!pref_maintenance_.save(&maintenance_)) {
+    ESP_LOGW(TAG, "Failed to save maintenance counters");
+  }
+}
+
+void VevorHeater::load_maintenance() {
+  MaintenanceData data;
+  if (pref_maintenance_.load(&data)) {
+    maintenance_ = data;
+    ESP_LOGI(TAG, "Loaded maintenance counters: %.1f burner hours, %" PRIu32 " ignitions", get_burner_hours(),
+             maintenance_.ignitions);
+  }
+  publish_maintenance_state();
+}
+
+void VevorHeater::set_frame_capture_enabled(bool enabled) {
+  if (enabled == frame_capture_.is_enabled()) {
+    return;
+  }
+  if (enabled) {
+    frame_capture_.enable(frame_capture_capacity_);
+    ESP_LOGI(TAG, "Frame capture started (%d frames, %u bytes)", frame_capture_capacity_,
+             (unsigned) (frame_capture_capacity_ * CAPTURE_FRAME_SIZE));
+  } else {
+    // Dump before freeing so a capture is never lost by switching off
+    dump_frame_capture();
+    frame_capture_.disable();
+    ESP_LOGI(TAG, "Frame capture stopped");
+  }
+}
+
+void VevorHeater::dump_frame_capture() {
+  if (!frame_capture_.is_enabled()) {
+    ESP_LOGW(TAG, "Frame capture is not enabled");
+    return;
+  }
+  frame_capture_.dump(TAG);
+}
+
+const char* VevorHeater::fault_to_string(FaultCode code) {
+  switch (code) {
+    case FaultCode::NONE: return "None";
+    case FaultCode::IGNITION_FAILURE: return "Ignition Failure";
+    case FaultCode::FLAME_OUT: return "Flame Out";
+    case FaultCode::OVERHEAT: return "Overheat";
+    case FaultCode::PUMP_FAULT: return "Pump Fault";
+    case FaultCode::LOW_VOLTAGE: return "Low Voltage";
+    case FaultCode::COMMUNICATION_LOST: return "Communication Lost";
+    case FaultCode::UNKNOWN_STATE: return "Unknown State";
+    default: return "Unknown";
+  }
+}
+
 const char* VevorHeater::state_to_string(HeaterState state) {
   switch (state) {
     case HeaterState::OFF: return "Off";
@@ -735,11 +2261,50 @@ void VevorHeater::set_control_mode(ControlMode mode) {
 }
 
 void VevorHeater::turn_on() {
+  if (controller_.is_locked_out()) {
+    ESP_LOGW(TAG, "Cannot start heater: controller locked out");
+    return;
+  }
+  bool was_enabled = is_heater_enabled();
+  if (!controller_.dispatch(ControllerEvent::START_REQUEST)) {
+    return;  // Refused by can_start_heater(), which logged the reason
+  }
+  if (!was_enabled) {
+    latency_start_ = true;
+    latency_.mark_intent(millis());
+  }
+  
+  // Set to default power level on turn on
+  power_level_ = static_cast<uint8_t>(default_power_percent_ / 10.0f);
+  ESP_LOGI(TAG, "Heater turned ON at %.0f%% power", default_power_percent_);
+}
+
+void VevorHeater::turn_off() {
+  bool was_enabled = is_heater_enabled();
+  controller_.dispatch(ControllerEvent::STOP_REQUEST);
+  if (was_enabled && !is_heater_enabled()) {
+    latency_start_ = false;
+    latency_.mark_intent(millis());
+  }
+  ESP_LOGI(TAG, "Heater turned OFF");
+}
+
+void VevorHeater::reset_controller() {
+  ESP_LOGI(TAG, "Controller reset from %s, clearing %d failed starts",
+           ControllerStateMachine::state_to_string(controller_.state()), restart_policy_.failures());
+  restart_policy_.reset();
+  controller_.dispatch(ControllerEvent::RESET);
+  restart_dirty_ = true;
+  mark_fuel_data_dirty(true);
+  publish_restart_state();
+}
+
+bool VevorHeater::can_start_heater() {
   // Check if automatic mode requires external sensor
   if (control_mode_ == ControlMode::AUTOMATIC) {
     if (!has_external_sensor()) {
       ESP_LOGE(TAG, "Cannot turn on heater: automatic mode requires external temperature sensor!");
-      return;
+      return false;
     }
   }
   
@@ -751,18 +2316,306 @@ void VevorHeater::turn_on() {
     if (low_voltage_error_sensor_) {
       low_voltage_error_sensor_->publish_state(true);
     }
+    return false;
+  }
+  
+  if (low_fuel_ && low_fuel_shutdown_) {
+    ESP_LOGW(TAG, "Cannot start heater: fuel tank low (%.1f%%)", get_tank_level_percent());
+    return false;
+  }
+  
+  uint32_t backoff = restart_policy_.backoff_remaining(millis());
+  if (backoff > 0) {
+    ESP_LOGW(TAG, "Cannot start heater: restart backoff after %d failed starts, %" PRIu32 " s remaining",
+             restart_policy_.failures(), backoff / 1000);
+    return false;
+  }
+  
+  // Re-igniting a hot heat exchanger during or right after cooldown thermally cycles it
+  if (is_heat_exchanger_hot()) {
+    ESP_LOGW(TAG, "Cannot start heater: heat exchanger still cooling (%.0f°C > %.0f°C)",
+             heat_exchanger_temperature_, restart_temperature_);
+    return false;
+  }
+  return true;
+}
+
+bool VevorHeater::is_heat_exchanger_hot() const {
+  // A burning heater is not restarted, only one that is off or cooling down
+  bool stopped = current_state_ == HeaterState::OFF || current_state_ == HeaterState::STOPPING_COOLING;
+  return stopped && heat_exchanger_temperature_ > restart_temperature_;
+}
+
+bool VevorHeater::is_start_deferred() {
+  return controller_.is_locked_out() || restart_policy_.backoff_remaining(millis()) > 0 || is_heat_exchanger_hot();
+}
+
+void VevorHeater::update_controller_intent() {
+  bool heat_requested = controller_.is_heat_requested();
+  // Until a frame confirms OFF, a stop is still in progress - whichever state the controller is in
+  bool shutdown_pending = !heat_requested && controller_.heater_phase() != ControllerEvent::HEATER_OFF;
+  if (controller_.state() == ControllerState::STOPPING) {
+    shutdown_pending = true;
+  }
+  
+  if (heat_requested == intent_heat_requested_ && shutdown_pending == shutdown_pending_) {
     return;
   }
+  if (shutdown_pending_ && !shutdown_pending && controller_.heater_phase() == ControllerEvent::HEATER_OFF) {
+    ESP_LOGI(TAG, "Shutdown complete, heater confirmed off");
+  }
+  intent_heat_requested_ = heat_requested;
+  shutdown_pending_ = shutdown_pending;
+  intent_dirty_ = true;
+  mark_fuel_data_dirty(true);
+}
+
+void VevorHeater::save_controller_intent() {
+  ControllerIntentData data;
+  data.heat_requested = intent_heat_requested_ ? 1 : 0;
+  data.shutdown_pending = shutdown_pending_ ? 1 : 0;
+  data.power_level = power_level_;
+  
+  if (!pref_controller_intent_.save(&data)) {
+    ESP_LOGW(TAG, "Failed to save controller intent");
+  }
+}
+
+void VevorHeater::load_controller_intent() {
+  ControllerIntentData data;
+  if (!pref_controller_intent_.load(&data)) {
+    return;
+  }
+  if (data.power_level >= 1 && data.power_level <= 10) {
+    power_level_ = data.power_level;
+  }
+  intent_heat_requested_ = data.heat_requested != 0;
+  shutdown_pending_ = data.shutdown_pending != 0;
   
-  heater_enabled_ = true;
-  // Set to default power level on turn on
-  power_level_ = static_cast<uint8_t>(default_power_percent_ / 10.0f);
-  ESP_LOGI(TAG, "Heater turned ON at %.0f%% power", default_power_percent_);
+  if (controller_.state() != ControllerState::IDLE) {
+    return;  // Latched lockout restored, it keeps the heater stopped on its own
+  }
+  if (shutdown_pending_) {
+    // Keep stopping until a heater frame confirms OFF
+    ESP_LOGW(TAG, "Reboot during shutdown, re-asserting stop until the heater reports off");
+    controller_.restore(ControllerState::STOPPING);
+  } else if (intent_heat_requested_ && resume_after_reboot_) {
+    ESP_LOGI(TAG, "Heater was on before reboot, resuming at first status frame");
+    resume_pending_ = true;
+  }
 }
 
-void VevorHeater::turn_off() {
-  heater_enabled_ = false;
-  ESP_LOGI(TAG, "Heater turned OFF");
+void VevorHeater::update_warm_start() {
+  WarmStartData data = warm_start_;
+  data.version = WARM_START_VERSION;
+  data.control_mode = static_cast<uint8_t>(control_mode_);
+  data.configured_mode = static_cast<uint8_t>(configured_mode_);
+  data.antifreeze_active = antifreeze_active_ ? 1 : 0;
+  data.last_antifreeze_power = last_antifreeze_power_;
+  
+  // Until the heater answers, the values are still the restored ones
+  bool refresh_due = false;
+  if (frame_received_) {
+    const StatusSnapshot &snap = status_snapshot_;
+    data.heater_state = snap.heater_state_code;
+    data.power_level = snap.power_level;
+    data.cooling_down = snap.cooling_down ? 1 : 0;
+    data.state_duration = snap.state_duration;
+    data.fan_speed = snap.fan_speed;
+    data.input_voltage = snap.input_voltage;
+    data.glow_plug_current = snap.glow_plug_current;
+    data.heat_exchanger_temperature = snap.heat_exchanger_temperature;
+    data.pump_frequency = snap.pump_frequency;
+    refresh_due = millis() - last_warm_start_save_ >= WARM_START_REFRESH_MS;
+  }
+  
+  // Mode and state changes are saved with the next commit, the values only refresh slowly
+  bool changed = data.version != warm_start_.version || data.control_mode != warm_start_.control_mode ||
+                 data.configured_mode != warm_start_.configured_mode ||
+                 data.antifreeze_active != warm_start_.antifreeze_active ||
+                 data.heater_state != warm_start_.heater_state || data.power_level != warm_start_.power_level;
+  if (!changed && !refresh_due) {
+    return;
+  }
+  if (frame_received_) {
+    data.timestamp = get_unix_time();
+  }
+  warm_start_ = data;
+  last_warm_start_save_ = millis();
+  warm_start_dirty_ = true;
+  mark_fuel_data_dirty();
+}
+
+void VevorHeater::save_warm_start() {
+  if (!pref_warm_start_.save(&warm_start_)) {
+    ESP_LOGW(TAG, "Failed to save warm start snapshot");
+  }
+}
+
+void VevorHeater::load_warm_start() {
+  WarmStartData data;
+  if (!pref_warm_start_.load(&data) || data.version != WARM_START_VERSION) {
+    return;
+  }
+  warm_start_ = data;
+  
+  // A runtime mode selection survives, unless the YAML mode changed since it was saved
+  if (data.configured_mode == static_cast<uint8_t>(configured_mode_) &&
+      data.control_mode <= static_cast<uint8_t>(ControlMode::ANTIFREEZE)) {
+    control_mode_ = static_cast<ControlMode>(data.control_mode);
+    // Antifreeze only owns the run if the heater resumes from the restored intent
+    if (control_mode_ == ControlMode::ANTIFREEZE && resume_pending_ && data.antifreeze_active != 0) {
+      antifreeze_active_ = true;
+      last_antifreeze_power_ = data.last_antifreeze_power;
+    }
+  }
+  
+  // Without synced time at boot the age is unknown, the values are marked stale either way
+  uint32_t now = get_unix_time();
+  if (now != 0 && data.timestamp != 0 && now - data.timestamp > WARM_START_MAX_AGE_S) {
+    ESP_LOGD(TAG, "Warm start values are %u s old, not shown", (unsigned) (now - data.timestamp));
+    return;
+  }
+  if (data.heater_state > static_cast<uint8_t>(HeaterState::STOPPING_COOLING)) {
+    return;  // Never saved from a frame
+  }
+  
+  // Display only: control keeps its safe defaults until the first frame
+  HeaterState state = static_cast<HeaterState>(data.heater_state);
+  if (state_sensor_) {
+    state_sensor_->publish_state(state_to_string(state));
+  }
+  if (power_level_sensor_ && data.power_level > 0 && data.power_level <= 10) {
+    power_level_sensor_->publish_state(data.power_level * 10);
+  }
+  if (input_voltage_sensor_ && data.input_voltage > 0.0f) {
+    input_voltage_sensor_->publish_state(data.input_voltage);
+  }
+  if (glow_plug_current_sensor_) {
+    glow_plug_current_sensor_->publish_state(data.glow_plug_current);
+  }
+  if (cooling_down_sensor_) {
+    cooling_down_sensor_->publish_state(data.cooling_down != 0);
+  }
+  if (heat_exchanger_temperature_sensor_) {
+    heat_exchanger_temperature_sensor_->publish_state(data.heat_exchanger_temperature);
+  }
+  if (state_duration_sensor_) {
+    state_duration_sensor_->publish_state(data.state_duration);
+  }
+  if (pump_frequency_sensor_) {
+    pump_frequency_sensor_->publish_state(data.pump_frequency);
+  }
+  if (fan_speed_sensor_) {
+    fan_speed_sensor_->publish_state(data.fan_speed);
+  }
+  
+  StatusSnapshot &snap = status_snapshot_;
+  snap.set(snap.heater_state, state_to_string(state));
+  snap.set(snap.heater_state_code, data.heater_state);
+  snap.set(snap.power_level, data.power_level);
+  snap.set(snap.input_voltage, data.input_voltage);
+  snap.set(snap.glow_plug_current, data.glow_plug_current);
+  snap.set(snap.cooling_down, data.cooling_down != 0);
+  snap.set(snap.heat_exchanger_temperature, data.heat_exchanger_temperature);
+  snap.set(snap.state_duration, data.state_duration);
+  snap.set(snap.pump_frequency, data.pump_frequency);
+  snap.set(snap.fan_speed, data.fan_speed);
+  snap.set(snap.stale, true);
+  ESP_LOGI(TAG, "Warm start: last known state %s, %.1fV, HX %.1f°C (stale until the first frame)",
+           state_to_string(state), data.input_voltage, data.heat_exchanger_temperature);
+}
+
+void VevorHeater::on_controller_transition(ControllerState from, ControllerState to, ControllerEvent event) {
+  ESP_LOGI(TAG, "Controller %s -> %s (%s)", ControllerStateMachine::state_to_string(from),
+           ControllerStateMachine::state_to_string(to), ControllerStateMachine::event_to_string(event));
+  if (controller_state_sensor_) {
+    controller_state_sensor_->publish_state(ControllerStateMachine::state_to_string(to));
+  }
+  status_snapshot_.set(status_snapshot_.controller_state, ControllerStateMachine::state_to_string(to));
+  status_snapshot_.set(status_snapshot_.controller_state_code, static_cast<uint8_t>(to));
+  status_snapshot_.set(status_snapshot_.locked_out, to == ControllerState::LOCKOUT);
+  update_controller_intent();
+  
+  if (to == ControllerState::STARTING) {
+    start_confirmed_ = false;
+  }
+  // A heater that gives up before a confirmed run, or a low voltage stop, is a failed start.
+  // Flame-outs after a confirmed run are logged as faults but do not count against restarts.
+  if ((to == ControllerState::FAULT && !start_confirmed_) ||
+      (to == ControllerState::LOCKOUT && event == ControllerEvent::LOW_VOLTAGE)) {
+    record_start_failure(from, event);
+  }
+}
+
+void VevorHeater::record_start_failure(ControllerState from, ControllerEvent event) {
+  bool limit_reached = restart_policy_.record_failure(millis());
+  restart_dirty_ = true;
+  mark_fuel_data_dirty(true);
+  
+  if (limit_reached) {
+    ESP_LOGE(TAG, "Restart lockout: %d failed starts in a row, reset required", restart_policy_.failures());
+    controller_.dispatch(ControllerEvent::RESTART_LIMIT);
+  } else {
+    ESP_LOGW(TAG, "Failed start %d/%d (%s while %s), next start allowed in %" PRIu32 " s",
+             restart_policy_.failures(), restart_policy_.max_failures(),
+             ControllerStateMachine::event_to_string(event), ControllerStateMachine::state_to_string(from),
+             restart_policy_.backoff_remaining(millis()) / 1000);
+  }
+  publish_restart_state();
+}
+
+void VevorHeater::check_start_confirmed() {
+  if (start_confirmed_ || controller_.state() != ControllerState::RUNNING ||
+      current_state_ != HeaterState::STABLE_COMBUSTION || state_duration_ < START_CONFIRM_SECONDS) {
+    return;
+  }
+  start_confirmed_ = true;
+  if (restart_policy_.failures() > 0) {
+    ESP_LOGI(TAG, "Start confirmed after %d s stable combustion, clearing %d failed starts", state_duration_,
+             restart_policy_.failures());
+    restart_policy_.record_success();
+    restart_dirty_ = true;
+    mark_fuel_data_dirty(true);
+    publish_restart_state();
+  }
+}
+
+void VevorHeater::publish_restart_state() {
+  if (failed_starts_sensor_) {
+    failed_starts_sensor_->publish_state(restart_policy_.failures());
+  }
+  if (restart_lockout_sensor_) {
+    restart_lockout_sensor_->publish_state(controller_.is_latched());
+  }
+  status_snapshot_.set(status_snapshot_.failed_starts, restart_policy_.failures());
+  last_backoff_published_ = UINT32_MAX;  // Refresh the countdown on the next update
+}
+
+void VevorHeater::save_restart_policy() {
+  RestartPolicyData data;
+  data.failures = restart_policy_.failures();
+  data.latched = controller_.is_latched() ? 1 : 0;
+  data.backoff_remaining_ms = restart_policy_.backoff_remaining(millis());
+  
+  if (!pref_restart_policy_.save(&data)) {
+    ESP_LOGW(TAG, "Failed to save restart policy");
+  }
+}
+
+void VevorHeater::load_restart_policy() {
+  RestartPolicyData data;
+  if (pref_restart_policy_.load(&data)) {
+    restart_policy_.restore(data.failures, data.backoff_remaining_ms, millis());
+    if (data.latched) {
+      ESP_LOGW(TAG, "Restart lockout restored after reboot (%d failed starts), reset required", data.failures);
+      controller_.dispatch(ControllerEvent::RESTART_LIMIT);
+    } else if (data.failures > 0) {
+      ESP_LOGI(TAG, "Loaded restart policy: %d failed starts, %us backoff left", data.failures,
+               (unsigned) (data.backoff_remaining_ms / 1000));
+    }
+  }
+  publish_restart_state();
 }
 
 void VevorHeater::set_power_level_percent(float percent) {
@@ -773,22 +2626,116 @@ void VevorHeater::set_power_level_percent(float percent) {
   }
 }
 
+void VevorHeater::on_shutdown() {
+  // Flush whatever is still pending - this is the last chance before reboot/OTA
+  commit_shutdown_data();
+  global_preferences->sync();
+}
+
+void VevorHeater::on_safe_shutdown() {
+  commit_shutdown_data();
+}
+
+void VevorHeater::commit_shutdown_data() {
+  if (maintenance_unsaved_s_ > 0) {
+    maintenance_dirty_ = true;
+    mark_fuel_data_dirty(true);
+  }
+  // The backoff saved at the failure would restart in full after the reboot
+  if (restart_policy_.backoff_remaining(millis()) > 0) {
+    restart_dirty_ = true;
+    mark_fuel_data_dirty(true);
+  }
+  commit_pending_fuel_data(true);
+}
+
 void VevorHeater::dump_config() {
   ESP_LOGCONFIG(TAG, "Vevor Heater:");
   ESP_LOGCONFIG(TAG, "  Control Mode: %s", control_mode_ == ControlMode::AUTOMATIC ? "Automatic" : "Manual");
   ESP_LOGCONFIG(TAG, "  Default Power Level: %.0f%%", default_power_percent_);
   ESP_LOGCONFIG(TAG, "  Power Level: %d/10", power_level_);
+  ESP_LOGCONFIG(TAG, "  Controller State: %s", ControllerStateMachine::state_to_string(controller_.state()));
+  ESP_LOGCONFIG(TAG, "  Reject Bad Checksum: %s (%u mismatches)", YESNO(reject_bad_checksum_),
+                (unsigned) checksum_mismatches_);
+  if (bus_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  Bus Device ID: 0x%02X", device_id_);
+    ESP_LOGCONFIG(TAG, "  Addressed Requests: %s (request ID 0x%02X)", YESNO(addressed_requests_),
+                  addressed_requests_ ? request_address(device_id_) : CONTROLLER_ID);
+  }
+  if (uart_task_ != nullptr) {
+    ESP_LOGCONFIG(TAG, "  UART Task: %u frames received, %u dropped, %u requests sent, %u resyncs",
+                  (unsigned) uart_task_->frames(), (unsigned) uart_task_->dropped(), (unsigned) uart_task_->sent(),
+                  (unsigned) uart_task_->resyncs());
+  }
+  ESP_LOGCONFIG(TAG, "  Restart Temperature: %.0f°C, resume after reboot: %s", restart_temperature_,
+                YESNO(resume_after_reboot_));
+  ESP_LOGCONFIG(TAG, "  Failed Starts: %d/%d%s", restart_policy_.failures(), restart_policy_.max_failures(),
+                controller_.is_latched() ? " (locked out)" : "");
   ESP_LOGCONFIG(TAG, "  Target Temperature: %.1f°C", target_temperature_);
   ESP_LOGCONFIG(TAG, "  Injected per Pulse: %.2f ml", injected_per_pulse_);
   ESP_LOGCONFIG(TAG, "  Daily Consumption: %.2f ml", daily_consumption_ml_);
   ESP_LOGCONFIG(TAG, "  Total Fuel Pulses: %.1f", total_fuel_pulses_);
+  ESP_LOGCONFIG(TAG, "  Fuel Save Interval: %" PRIu32 " ms", fuel_save_interval_ms_);
+  ESP_LOGCONFIG(TAG, "  Pump Calibration: %d refills", refill_events_);
+  ESP_LOGCONFIG(TAG, "  Heating Value: %.2f kWh/L, efficiency %.0f%%-%.0f%% (levels 1-10)", heating_value_,
+                heater_efficiency_[0] * 100.0f, heater_efficiency_[CALIBRATION_BINS - 1] * 100.0f);
+  ESP_LOGCONFIG(TAG, "  Delivered Energy: %.2f kWh today, %.1f kWh total", get_daily_energy(), get_total_energy());
+  ESP_LOGCONFIG(TAG, "  Schedule: %s, %d events", schedule_enabled_ ? "enabled" : "disabled", schedule_event_count_);
+  for (uint8_t i = 0; i < MAX_SCHEDULE_SLOTS; i++) {
+    const ScheduleSlot &slot = schedule_slots_[i];
+    if (slot.days != 0) {
+      ESP_LOGCONFIG(TAG, "    Slot %d: days 0x%02X %02d:%02d-%02d:%02d power %d%% preheat %d min", i, slot.days,
+                    slot.start_minute / 60, slot.start_minute % 60, slot.end_minute / 60, slot.end_minute % 60,
+                    slot.power_percent, slot.preheat_minutes);
+    }
+  }
+  ESP_LOGCONFIG(TAG, "  Warm-up Model: ignition %.1f min", startup_minutes_);
+  for (uint8_t i = 0; i < 10; i++) {
+    if (warmup_stats_[i].n >= 0.5f) {
+      ESP_LOGCONFIG(TAG, "    Power %d%%: %.2f °C/min avg (%.1f samples)", (i + 1) * 10,
+                    warmup_stats_[i].sum_y / warmup_stats_[i].n, warmup_stats_[i].n);
+    }
+  }
+  ESP_LOGCONFIG(TAG, "  Overheat Temperature: %.0f°C", overheat_temperature_);
+  ESP_LOGCONFIG(TAG, "  Fault Log: %d entries, %" PRIu32 " faults total", fault_log_size_, get_total_fault_count());
+  for (uint8_t i = 0; i < fault_log_size_; i++) {
+    // Newest first
+    const FaultLogEntry &entry = fault_log_[(fault_log_head_ + FAULT_LOG_SIZE - 1 - i) % FAULT_LOG_SIZE];
+    ESP_LOGCONFIG(TAG, "    %" PRIu32 ": %s state=0x%02X %.1fV HX=%.1f°C raw=%02X %02X %02X %02X %02X %02X %02X %02X",
+                  entry.timestamp, fault_to_string(static_cast<FaultCode>(entry.code)), entry.state_raw,
+                  entry.voltage_x10 / 10.0f, entry.heat_exchanger_x10 / 10.0f, entry.raw[0], entry.raw[1],
+                  entry.raw[2], entry.raw[3], entry.raw[4], entry.raw[5], entry.raw[6], entry.raw[7]);
+  }
+  if (has_tank()) {
+    ESP_LOGCONFIG(TAG, "  Tank Capacity: %.1f L", tank_capacity_ml_ / 1000.0f);
+    ESP_LOGCONFIG(TAG, "  Tank Remaining: %.2f L", tank_remaining_ml_ / 1000.0f);
+    ESP_LOGCONFIG(TAG, "  Low Fuel Threshold: %.0f%% (shutdown %s)", low_fuel_threshold_percent_, YESNO(low_fuel_shutdown_));
+  }
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    if (calibration_factor_[i] != 1.0f) {
+      ESP_LOGCONFIG(TAG, "    Power %d%%: factor %.3f", (i + 1) * 10, calibration_factor_[i]);
+    }
+  }
   
-  if (external_temperature_sensor_ != nullptr) {
-    ESP_LOGCONFIG(TAG, "  External Temperature Sensor: Configured");
+  ESP_LOGCONFIG(TAG, "  Burner Hours: %.1f h, %" PRIu32 " ignitions", get_burner_hours(), maintenance_.ignitions);
+  for (uint8_t i = 0; i < CALIBRATION_BINS; i++) {
+    if (maintenance_.fan_seconds[i] > 0) {
+      ESP_LOGCONFIG(TAG, "    Fan at %d%%: %.1f h", (i + 1) * 10, maintenance_.fan_seconds[i] / 3600.0f);
+    }
+  }
+  if (service_interval_seconds_ > 0 || service_interval_ignitions_ > 0) {
+    ESP_LOGCONFIG(TAG, "  Service Interval: %.0f h / %" PRIu32 " ignitions (%.1f h, %" PRIu32 " since service%s)",
+                  service_interval_seconds_ / 3600.0f, service_interval_ignitions_, get_burner_hours_since_service(),
+                  get_ignitions_since_service(), service_due_ ? ", due" : "");
+  }
+  compensation_.dump_config(TAG);
+  latency_.dump_config(TAG);
+  if (temperature_inputs_.has_inputs()) {
+    temperature_inputs_.dump_config(TAG);
     if (has_external_sensor()) {
-      ESP_LOGCONFIG(TAG, "    Current Reading: %.1f°C", external_temperature_);
+      ESP_LOGCONFIG(TAG, "    Control Temperature: %.1f°C", external_temperature_);
     } else {
-      ESP_LOGCONFIG(TAG, "    Current Reading: No data");
+      ESP_LOGCONFIG(TAG, "    Control Temperature: No data");
     }
   } else {
     ESP_LOGCONFIG(TAG, "  External Temperature Sensor: Not configured");
@@ -811,6 +2758,31 @@ void VevorHeater::dump_config() {
   LOG_SENSOR("  ", "Daily Consumption", daily_consumption_sensor_);
   LOG_SENSOR("  ", "Total Consumption", total_consumption_sensor_);
   LOG_BINARY_SENSOR("  ", "Low Voltage Error", low_voltage_error_sensor_);
+  LOG_SENSOR("  ", "Fuel Since Refill", fuel_since_refill_sensor_);
+  LOG_SENSOR("  ", "Thermal Power", thermal_power_sensor_);
+  LOG_SENSOR("  ", "Daily Energy", daily_energy_sensor_);
+  LOG_SENSOR("  ", "Total Energy", total_energy_sensor_);
+  LOG_SENSOR("  ", "Effective Max Power", effective_max_power_sensor_);
+  LOG_SENSOR("  ", "Effective Injected Per Pulse", effective_injected_per_pulse_sensor_);
+  LOG_SENSOR("  ", "Tank Remaining", tank_remaining_sensor_);
+  LOG_SENSOR("  ", "Tank Level", tank_level_sensor_);
+  LOG_SENSOR("  ", "Tank Hours Left", tank_hours_left_sensor_);
+  LOG_BINARY_SENSOR("  ", "Low Fuel", low_fuel_sensor_);
+  LOG_TEXT_SENSOR("  ", "Schedule Next Event", schedule_next_event_sensor_);
+  LOG_SENSOR("  ", "Preheat Lead Time", preheat_lead_time_sensor_);
+  LOG_SENSOR("  ", "Fault Count", fault_count_sensor_);
+  LOG_TEXT_SENSOR("  ", "Last Fault", last_fault_sensor_);
+  LOG_TEXT_SENSOR("  ", "Controller State", controller_state_sensor_);
+  LOG_SENSOR("  ", "Failed Starts", failed_starts_sensor_);
+  LOG_SENSOR("  ", "Restart Backoff Remaining", restart_backoff_sensor_);
+  LOG_BINARY_SENSOR("  ", "Restart Lockout", restart_lockout_sensor_);
+  LOG_SENSOR("  ", "Cooldown Time", cooldown_time_sensor_);
+  LOG_SENSOR("  ", "Burner Hours", burner_hours_sensor_);
+  LOG_SENSOR("  ", "Fan Hours", fan_hours_sensor_);
+  LOG_SENSOR("  ", "Ignition Count", ignition_count_sensor_);
+  LOG_SENSOR("  ", "Burner Hours Since Service", burner_hours_since_service_sensor_);
+  LOG_SENSOR("  ", "Ignitions Since Service", ignitions_since_service_sensor_);
+  LOG_BINARY_SENSOR("  ", "Service Due", service_due_sensor_);
 }
 
 }  // namespace vevor_heater
@@ -12,8 +12,25 @@
 #include "esphome/components/select/select.h"
 #include "esphome/components/switch/switch.h"
 #include "esphome/core/preferences.h"
+#include "controller_state.h"
+#include "heater_profile.h"
+#include "frame_receiver.h"
+#include "frame_capture.h"
+#include "vevor_bus.h"
+#include "status_snapshot.h"
+#include "temperature_aggregator.h"
+#include "compensation.h"
+#include "latency_tracker.h"
+#include <algorithm>
 #include <vector>
 
+#ifdef USE_VEVOR_STATUS_ENDPOINT
+#include "esphome/components/web_server_base/web_server_base.h"
+#endif
+#ifdef USE_VEVOR_MQTT_TELEMETRY
+#include "esphome/components/mqtt/mqtt_client.h"
+#endif
+
 namespace esphome {
 
 // Forward declaration for optional time component
@@ -23,8 +40,19 @@ namespace vevor_heater {
 
 static const char *const TAG = "vevor_heater";
 
+class UartTask;
+
 // Fuel consumption constants
-static const float INJECTED_PER_PULSE = 0.022f; // ml per fuel pump pulse
+static const float INJECTED_PER_PULSE = HEATER_PROFILE.injected_per_pulse; // ml per fuel pump pulse
+static const uint8_t CALIBRATION_BINS = 10;     // One pump calibration factor per power level
+static const float CALIBRATION_FORGETTING = 0.8f;  // Weight kept by older refills on each new one
+static const float CALIBRATION_MIN_FACTOR = 0.5f;
+static const float CALIBRATION_MAX_FACTOR = 2.0f;
+static const float BURN_RATE_TIME_CONSTANT_S = 600.0f;  // EWMA time constant for per level burn rate
+
+// Energy accounting constants
+static const float DEFAULT_HEATING_VALUE = 9.88f;     // Diesel lower heating value, kWh/L (= Wh/ml)
+static const float DEFAULT_HEATER_EFFICIENCY = 0.85f;  // Share of the fuel energy delivered as heat
 
 // Control modes
 enum class ControlMode : uint8_t {
@@ -43,22 +71,163 @@ enum class HeaterState : uint8_t {
   UNKNOWN = 0xFF
 };
 
-// Controller command states
-enum class ControllerState : uint8_t {
-  CMD_OFF = 0x02,
-  CMD_START = 0x06,
-  CMD_RUNNING = 0x08
+// Fault classification. The status frame carries no documented error code, so faults are
+// derived from state transitions and frame values; unknown states keep their raw bytes.
+enum class FaultCode : uint8_t {
+  NONE = 0,
+  IGNITION_FAILURE = 1,   // Start sequence aborted before stable combustion
+  FLAME_OUT = 2,          // Left stable combustion without a stop command
+  OVERHEAT = 3,           // Heat exchanger above overheat_temperature
+  PUMP_FAULT = 4,         // Stable combustion reported with the pump stopped
+  LOW_VOLTAGE = 5,        // Start refused or run stopped by low voltage
+  COMMUNICATION_LOST = 6, // Heater stopped answering while active
+  UNKNOWN_STATE = 7,      // State byte outside HeaterState, see raw bytes
+};
+static const uint8_t FAULT_CODE_COUNT = 8;
+static const uint8_t FAULT_LOG_SIZE = 16;
+static const uint8_t FAULT_RAW_BYTES = PROFILE_UNDECODED_BYTES;
+static const uint8_t PUMP_FAULT_FRAMES = 3;  // Consecutive frames before a pump fault is raised
+
+struct FaultLogEntry {
+  uint32_t timestamp;             // Unix time, 0 if time was not synced
+  uint8_t code;                   // FaultCode
+  uint8_t state_raw;              // Raw state byte at fault time
+  uint8_t voltage_x10;
+  uint8_t power_level;
+  int16_t heat_exchanger_x10;
+  int16_t external_x10;           // INT16_MIN if no external sensor
+  uint8_t raw[FAULT_RAW_BYTES];   // Bytes at the profile's undecoded offsets
+};
+
+struct FaultLogData {
+  FaultLogEntry entries[FAULT_LOG_SIZE];
+  uint16_t counts[FAULT_CODE_COUNT];
+  uint8_t head;   // Next slot to write
+  uint8_t size;
+};
+
+// Failed start counter, persisted so a reboot does not clear a latched lockout or
+// shorten the restart backoff
+struct RestartPolicyData {
+  uint8_t failures;
+  uint8_t latched;
+  uint32_t backoff_remaining_ms;  // At the last save, restarts from there after a reboot
+};
+
+// Control intent, persisted so a reboot mid-cooldown keeps stopping and a reboot while
+// running resumes instead of stopping the heater
+struct ControllerIntentData {
+  uint8_t heat_requested;    // Starting or running, resume after reboot
+  uint8_t shutdown_pending;  // Stop requested, heater not yet confirmed OFF
+  uint8_t power_level;
+};
+
+// Last heater report and control mode, restored at boot so entities show the last
+// known values until the first frame arrives. Display only, never used for control.
+static const uint8_t WARM_START_VERSION = 1;
+static const uint32_t WARM_START_REFRESH_MS = 900000;  // Value refresh while the state is unchanged
+static const uint32_t WARM_START_MAX_AGE_S = 86400;    // Older values are not shown
+static const uint32_t BOOT_POLL_BURST_MS = 15000;      // Poll every second after boot until the heater answers
+
+struct WarmStartData {
+  uint8_t version;
+  uint8_t control_mode;
+  uint8_t configured_mode;  // Control mode from YAML when saved, a changed config wins
+  uint8_t antifreeze_active;
+  uint8_t heater_state;
+  uint8_t power_level;      // As reported by the heater, 1-10
+  uint8_t cooling_down;
+  uint8_t reserved;
+  uint16_t state_duration;
+  uint16_t fan_speed;
+  float last_antifreeze_power;
+  float input_voltage;
+  float glow_plug_current;
+  float heat_exchanger_temperature;
+  float pump_frequency;
+  uint32_t timestamp;       // Unix time of the values, 0 if time was not synced
+};
+
+// Runtime counters for service planning. Seconds accumulate in RAM per frame and are
+// only queued for flash every MAINTENANCE_SAVE_INTERVAL_S of new runtime, or on an
+// ignition, riding the coalesced fuel data commit like everything else.
+static const uint32_t MAINTENANCE_SAVE_INTERVAL_S = 600;
+static const uint32_t MAINTENANCE_MAX_FRAME_GAP_MS = 5000;  // Longer gaps are not counted as runtime
+
+struct MaintenanceData {
+  uint32_t burner_seconds;                  // HEATING_UP and STABLE_COMBUSTION
+  uint32_t fan_seconds[CALIBRATION_BINS];   // Heater running or cooling, per power level
+  uint32_t ignitions;                       // Starts that reached HEATING_UP
+  uint32_t service_burner_seconds;          // Totals at the last service
+  uint32_t service_ignitions;
 };
 
-// Communication constants
-static const uint8_t FRAME_START = 0xAA;
-static const uint8_t CONTROLLER_ID = 0x66;
-static const uint8_t HEATER_ID = 0x77;
-static const uint8_t CONTROLLER_FRAME_LENGTH = 0x0B;
-static const uint8_t HEATER_FRAME_LENGTH = 0x33;
+// Stable combustion must last this long (state duration, s) before a start counts as successful
+static const uint16_t START_CONFIRM_SECONDS = 120;
+
+// Communication timing, framing constants are in frame_receiver.h
 static const uint32_t COMMUNICATION_TIMEOUT_MS = 5000;
 static const uint32_t SEND_INTERVAL_MS = 1000;
 static const uint32_t DEFAULT_POLLING_INTERVAL_MS = 300000; // 1 minute when not heating
+static const uint32_t DEFAULT_FUEL_SAVE_INTERVAL_MS = 30000;  // Max fuel data at risk on power loss
+static const uint32_t LATENCY_PUBLISH_INTERVAL_MS = 60000;
+
+// On-device weekly schedule
+static const uint8_t MAX_SCHEDULE_SLOTS = 8;
+static const uint16_t MINUTES_PER_DAY = 24 * 60;
+static const uint16_t MINUTES_PER_WEEK = 7 * MINUTES_PER_DAY;
+static const uint16_t SCHEDULE_MINUTE_INVALID = 0xFFFF;
+static const uint8_t SCHEDULE_SLOT_NONE = 0xFF;
+static const int16_t SCHEDULE_NO_TARGET = INT16_MIN;
+static const uint8_t SCHEDULE_PREHEAT_AUTO = 0xFF;       // Lead time from the warm-up predictor
+static const uint8_t MAX_AUTO_PREHEAT_MINUTES = 180;     // Earliest an auto preheat may start
+static const uint8_t DEFAULT_AUTO_PREHEAT_MINUTES = 30;  // Used until the predictor has data
+
+// Warm-up learning for optimal start
+static const float WARMUP_FORGETTING = 0.95f;
+static const float WARMUP_MIN_RISE = 1.0f;              // °C needed for a usable sample
+static const uint32_t WARMUP_MIN_DURATION_MS = 5 * 60 * 1000;
+static const uint32_t WARMUP_MAX_DURATION_MS = 60 * 60 * 1000;
+static const float WARMUP_MIN_RATE = 0.02f;             // °C/min
+static const float WARMUP_MAX_RATE = 5.0f;
+
+struct ScheduleSlot {
+  uint8_t days;                    // Bit 0 = Sunday ... bit 6 = Saturday, 0 = slot unused
+  uint8_t power_percent;           // 10-100, 0 = keep current power
+  uint16_t start_minute;           // Minutes after local midnight
+  uint16_t end_minute;             // End before start wraps past midnight
+  int16_t target_temperature_x10;  // SCHEDULE_NO_TARGET = no temperature target
+  uint8_t preheat_minutes;         // Start this much before start_minute, SCHEDULE_PREHEAT_AUTO = predicted
+  uint8_t reserved;
+};
+
+struct ScheduleData {
+  uint32_t config_hash;  // Hash of the YAML schedule, a changed YAML overrides runtime edits
+  bool enabled;
+  ScheduleSlot slots[MAX_SCHEDULE_SLOTS];
+};
+
+// Precomputed schedule transition, sorted by minute of week
+struct ScheduleEvent {
+  uint16_t week_minute;
+  uint8_t slot;
+  bool start;
+};
+
+// Warm-up rate model: per power level linear fit of rate (°C/min) over starting temperature,
+// kept as exponentially forgotten sufficient statistics
+struct WarmupStats {
+  float n;
+  float sum_x;
+  float sum_y;
+  float sum_xx;
+  float sum_xy;
+};
+
+struct WarmupModelData {
+  WarmupStats stats[10];
+  float startup_minutes;  // Enable to stable combustion, smoothed
+};
 
 // Fuel consumption tracking structure for persistence
 struct FuelConsumptionData {
@@ -67,6 +236,31 @@ struct FuelConsumptionData {
   float total_pulses;  // Keep as float to avoid precision loss
 };
 
+// Delivered heat counters. Whole Wh are kept as integers so the lifetime total
+// never loses small per-frame increments to float rounding.
+struct EnergyData {
+  uint32_t daily_wh;
+  uint32_t total_wh;
+  float fraction_wh;  // Not yet carried into the counters, always below 1 Wh
+  uint32_t last_reset_day;
+};
+
+// Learned pump calibration, fitted by least squares over logged refills.
+// Factors are relative to injected_per_pulse so the base value stays adjustable.
+struct PumpCalibrationData {
+  float factor[CALIBRATION_BINS];
+  float normal_matrix[CALIBRATION_BINS * (CALIBRATION_BINS + 1) / 2];  // Upper triangle of A^T A
+  float normal_vector[CALIBRATION_BINS];                                // A^T b
+  float refill_pulses[CALIBRATION_BINS];  // Raw pulses per power level since the last refill
+  uint16_t refill_events;
+};
+
+// Fuel tank model persisted separately so it can be enabled on existing installs
+struct FuelTankData {
+  float remaining_ml;
+  float burn_rate_ml_h[CALIBRATION_BINS];  // Smoothed consumption per power level
+};
+
 class VevorHeater : public PollingComponent, public uart::UARTDevice {
  public:
   // Configuration methods
@@ -77,8 +271,33 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   void set_control_mode(ControlMode mode);
   void set_default_power_percent(float percent) { default_power_percent_ = percent; }
   void set_injected_per_pulse(float ml_per_pulse) { injected_per_pulse_ = ml_per_pulse; }
+  void set_heating_value(float kwh_per_liter) { heating_value_ = kwh_per_liter; }
+  void set_heater_efficiency(uint8_t level, float efficiency) {
+    if (level >= 1 && level <= CALIBRATION_BINS) heater_efficiency_[level - 1] = efficiency;
+  }
   float get_injected_per_pulse() const { return injected_per_pulse_; }
+  void set_refill_volume(float volume_ml) { refill_volume_ml_ = volume_ml; }
+  float get_refill_volume() const { return refill_volume_ml_; }
+  void set_tank_capacity(float litres) { tank_capacity_ml_ = litres * 1000.0f; }
+  void set_low_fuel_threshold(float percent) { low_fuel_threshold_percent_ = percent; }
+  void set_low_fuel_shutdown(bool shutdown) { low_fuel_shutdown_ = shutdown; }
+  
+  // Schedule configuration (YAML defaults, may be edited at runtime)
+  void add_schedule_slot(uint8_t days, uint16_t start_minute, uint16_t end_minute, uint8_t power_percent,
+                         float target_temperature, uint8_t preheat_minutes);
+  void set_schedule_config_hash(uint32_t hash) { schedule_config_hash_ = hash; }
+  void set_overheat_temperature(float temperature) { overheat_temperature_ = temperature; }
+  void set_frame_capture_capacity(uint16_t capacity) { frame_capture_capacity_ = capacity; }
+  void set_max_start_failures(uint8_t failures) { restart_policy_.set_max_failures(failures); }
+  void set_restart_backoff(uint32_t backoff_ms) { restart_policy_.set_base_backoff(backoff_ms); }
+  void set_max_restart_backoff(uint32_t backoff_ms) { restart_policy_.set_max_backoff(backoff_ms); }
+  void set_restart_temperature(float temperature) { restart_temperature_ = temperature; }
+  void set_resume_after_reboot(bool resume) { resume_after_reboot_ = resume; }
   void set_polling_interval(uint32_t interval_ms) { polling_interval_ms_ = interval_ms; }
+  void set_device_id(uint8_t device_id) { device_id_ = device_id; }
+  void set_addressed_requests(bool addressed) { addressed_requests_ = addressed; }
+  void set_reject_bad_checksum(bool reject) { reject_bad_checksum_ = reject; }
+  void set_fuel_save_interval(uint32_t interval_ms) { fuel_save_interval_ms_ = interval_ms; }
   void set_min_voltage_start(float voltage) { min_voltage_start_ = voltage; }
   void set_min_voltage_operate(float voltage) { min_voltage_operate_ = voltage; }
   void set_antifreeze_temp_on(float temp) { antifreeze_temp_on_ = temp; }
@@ -92,8 +311,25 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   // Number component setter
   void set_injected_per_pulse_number(number::Number *num) { injected_per_pulse_number_ = num; }
   
-  // External temperature sensor
-  void set_external_temperature_sensor(sensor::Sensor *sensor) { external_temperature_sensor_ = sensor; }
+  // External temperature sensor, a single input that never goes stale
+  void set_external_temperature_sensor(sensor::Sensor *sensor) { temperature_inputs_.add_input(sensor, 1.0f, false, 0); }
+  // Several temperature inputs combined into the control temperature
+  void add_temperature_input(sensor::Sensor *sensor, float weight, bool critical, uint32_t max_age_ms) {
+    temperature_inputs_.add_input(sensor, weight, critical, max_age_ms);
+  }
+  void set_temperature_mode(AggregationMode mode) { temperature_inputs_.set_mode(mode); }
+  
+  // Altitude power derating and fuel temperature ml/pulse correction
+  void set_altitude(float altitude) { compensation_.set_altitude(altitude); }
+  void set_altitude_sensor(sensor::Sensor *sensor) { compensation_.set_altitude_sensor(sensor); }
+  void set_pressure_sensor(sensor::Sensor *sensor) { compensation_.set_pressure_sensor(sensor); }
+  void set_fuel_temperature_sensor(sensor::Sensor *sensor) { compensation_.set_fuel_temperature_sensor(sensor); }
+  void add_altitude_power_limit(float altitude, float max_power_percent) {
+    compensation_.power_limit().add_point(altitude, max_power_percent);
+  }
+  void add_fuel_temperature_correction(float temperature, float factor) {
+    compensation_.fuel_correction().add_point(temperature, factor);
+  }
   
   // Sensor setters - removed duplicate set_temperature_sensor
   void set_input_voltage_sensor(sensor::Sensor *sensor) { input_voltage_sensor_ = sensor; }
@@ -109,26 +345,124 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   void set_daily_consumption_sensor(sensor::Sensor *sensor) { daily_consumption_sensor_ = sensor; }
   void set_total_consumption_sensor(sensor::Sensor *sensor) { total_consumption_sensor_ = sensor; }
   void set_low_voltage_error_sensor(binary_sensor::BinarySensor *sensor) { low_voltage_error_sensor_ = sensor; }
+  void set_fuel_since_refill_sensor(sensor::Sensor *sensor) { fuel_since_refill_sensor_ = sensor; }
+  void set_thermal_power_sensor(sensor::Sensor *sensor) { thermal_power_sensor_ = sensor; }
+  void set_daily_energy_sensor(sensor::Sensor *sensor) { daily_energy_sensor_ = sensor; }
+  void set_total_energy_sensor(sensor::Sensor *sensor) { total_energy_sensor_ = sensor; }
+  void set_effective_max_power_sensor(sensor::Sensor *sensor) { effective_max_power_sensor_ = sensor; }
+  void set_effective_injected_per_pulse_sensor(sensor::Sensor *sensor) { effective_injected_per_pulse_sensor_ = sensor; }
+  void set_latency_sensor(LatencyMetric metric, LatencyStat stat, sensor::Sensor *sensor) {
+    latency_sensors_[static_cast<uint8_t>(metric)][static_cast<uint8_t>(stat)] = sensor;
+  }
+  void set_tank_remaining_sensor(sensor::Sensor *sensor) { tank_remaining_sensor_ = sensor; }
+  void set_tank_level_sensor(sensor::Sensor *sensor) { tank_level_sensor_ = sensor; }
+  void set_tank_hours_left_sensor(sensor::Sensor *sensor) { tank_hours_left_sensor_ = sensor; }
+  void set_low_fuel_sensor(binary_sensor::BinarySensor *sensor) { low_fuel_sensor_ = sensor; }
+  void set_schedule_next_event_sensor(text_sensor::TextSensor *sensor) { schedule_next_event_sensor_ = sensor; }
+  void set_preheat_lead_time_sensor(sensor::Sensor *sensor) { preheat_lead_time_sensor_ = sensor; }
+  void set_fault_count_sensor(sensor::Sensor *sensor) { fault_count_sensor_ = sensor; }
+  void set_last_fault_sensor(text_sensor::TextSensor *sensor) { last_fault_sensor_ = sensor; }
+  void set_controller_state_sensor(text_sensor::TextSensor *sensor) { controller_state_sensor_ = sensor; }
+  void set_failed_starts_sensor(sensor::Sensor *sensor) { failed_starts_sensor_ = sensor; }
+  void set_restart_backoff_sensor(sensor::Sensor *sensor) { restart_backoff_sensor_ = sensor; }
+  void set_restart_lockout_sensor(binary_sensor::BinarySensor *sensor) { restart_lockout_sensor_ = sensor; }
+  void set_burner_hours_sensor(sensor::Sensor *sensor) { burner_hours_sensor_ = sensor; }
+  void set_fan_hours_sensor(sensor::Sensor *sensor) { fan_hours_sensor_ = sensor; }
+  void set_ignition_count_sensor(sensor::Sensor *sensor) { ignition_count_sensor_ = sensor; }
+  void set_burner_hours_since_service_sensor(sensor::Sensor *sensor) { burner_hours_since_service_sensor_ = sensor; }
+  void set_ignitions_since_service_sensor(sensor::Sensor *sensor) { ignitions_since_service_sensor_ = sensor; }
+  void set_service_due_sensor(binary_sensor::BinarySensor *sensor) { service_due_sensor_ = sensor; }
+  void set_cooldown_time_sensor(sensor::Sensor *sensor) { cooldown_time_sensor_ = sensor; }
   
   // Control methods
   void turn_on();
   void turn_off();
+  void reset_controller();
   void set_power_level_percent(float percent);
   void reset_daily_consumption();
   void reset_total_consumption();
+  void log_refill(float volume_ml);
+  void reset_pump_calibration();
+  void refill_tank();
+  
+  // Schedule editing - changes are persisted and take effect immediately
+  bool set_schedule_slot(uint8_t index, uint8_t days, uint16_t start_minute, uint16_t end_minute,
+                         uint8_t power_percent, float target_temperature, uint8_t preheat_minutes);
+  bool clear_schedule_slot(uint8_t index);
+  void set_schedule_enabled(bool enabled);
+  bool is_schedule_enabled() const { return schedule_enabled_; }
+  bool has_schedule() const { return schedule_event_count_ > 0; }
+  
+  // Optimal start prediction - minutes needed to warm from start_temp to target at the given power
+  float predict_warmup_rate(float start_temp, uint8_t level) const;
+  float predict_preheat_minutes(float target, float start_temp, uint8_t level) const;
+  float get_preheat_lead_time() const { return preheat_lead_minutes_; }
+  
+  // Fault log
+  uint16_t get_fault_count(FaultCode code) const { return fault_counts_[static_cast<uint8_t>(code)]; }
+  uint32_t get_total_fault_count() const;
+  FaultCode get_last_fault() const { return last_fault_; }
+  void clear_fault_log();
+  
+  // Maintenance counters
+  void set_service_interval_hours(float hours) { service_interval_seconds_ = static_cast<uint32_t>(hours * 3600.0f); }
+  void set_service_interval_ignitions(uint32_t ignitions) { service_interval_ignitions_ = ignitions; }
+  float get_burner_hours() const { return maintenance_.burner_seconds / 3600.0f; }
+  float get_fan_hours() const;
+  uint32_t get_ignition_count() const { return maintenance_.ignitions; }
+  float get_burner_hours_since_service() const {
+    return (maintenance_.burner_seconds - maintenance_.service_burner_seconds) / 3600.0f;
+  }
+  uint32_t get_ignitions_since_service() const { return maintenance_.ignitions - maintenance_.service_ignitions; }
+  bool is_service_due() const { return service_due_; }
+  void reset_service_counters();
+  
+  // Status snapshot, JSON serialised on request and cached until a field changes.
+  // Callable from the web server task.
+  std::string get_status_json() { return status_snapshot_.to_json(); }
+#ifdef USE_VEVOR_STATUS_ENDPOINT
+  void set_status_endpoint(web_server_base::WebServerBase *base, const std::string &path) {
+    status_web_base_ = base;
+    status_path_ = path;
+  }
+#endif
+#ifdef USE_VEVOR_UART_TASK
+  // UART reads and request timing on a pinned FreeRTOS task
+  void set_uart_task(uint8_t core, uint8_t priority) {
+    uart_task_core_ = core;
+    uart_task_priority_ = priority;
+  }
+#endif
+#ifdef USE_VEVOR_MQTT_TELEMETRY
+  // One binary MQTT publish per batch interval instead of one per entity update
+  void set_telemetry(const std::string &topic, uint32_t interval_ms, bool on_state_change) {
+    telemetry_topic_ = topic;
+    telemetry_interval_ms_ = interval_ms;
+    telemetry_on_state_change_ = on_state_change;
+  }
+#endif
+  
+  // Raw frame capture for protocol reverse engineering
+  void set_frame_capture_enabled(bool enabled);
+  bool is_frame_capture_enabled() const { return frame_capture_.is_enabled(); }
+  void dump_frame_capture();
   
   // Control mode management
   bool is_automatic_mode() const { return control_mode_ == ControlMode::AUTOMATIC; }
   bool is_manual_mode() const { return control_mode_ == ControlMode::MANUAL; }
   bool is_antifreeze_mode() const { return control_mode_ == ControlMode::ANTIFREEZE; }
   float get_external_temperature() const { return external_temperature_; }
-  bool has_external_sensor() const { 
-    return external_temperature_sensor_ != nullptr && 
-           !std::isnan(external_temperature_); 
-  }
+  // True while at least one temperature input is fresh
+  bool has_external_sensor() const { return temperature_inputs_.has_value(); }
   
   // Status getters
   HeaterState get_heater_state() const { return current_state_; }
+  ControllerState get_controller_state() const { return controller_.state(); }
+  bool is_heater_enabled() const { return controller_.is_heat_requested(); }
+  uint8_t get_failed_starts() const { return restart_policy_.failures(); }
+  bool is_restart_locked_out() const { return controller_.is_latched(); }
+  uint32_t get_restart_backoff_remaining() const { return restart_policy_.backoff_remaining(millis()) / 1000; }
+  bool is_shutdown_pending() const { return shutdown_pending_; }
   float get_current_temperature() const { return current_temperature_; }
   bool is_heating() const { 
     return current_state_ == HeaterState::POLLING_STATE || 
@@ -140,12 +474,55 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   
   // Fuel consumption getters
   float get_daily_consumption() const { return daily_consumption_ml_; }
-  float get_instantaneous_consumption_rate() const { return pump_frequency_ * injected_per_pulse_ * 3600.0f; }
+  float get_instantaneous_consumption_rate() const { return pump_frequency_ * get_effective_ml_per_pulse() * 3600.0f; }
+  float get_fuel_since_refill() const { return fuel_since_refill_ml_; }
+  float get_heater_efficiency(uint8_t level) const {
+    if (level < 1 || level > CALIBRATION_BINS) return DEFAULT_HEATER_EFFICIENCY;
+    return heater_efficiency_[level - 1];
+  }
+  // Delivered heat in W from the current fuel flow
+  float get_thermal_power() const {
+    return get_instantaneous_consumption_rate() * heating_value_ * get_heater_efficiency(get_fuel_power_level());
+  }
+  float get_daily_energy() const { return (daily_energy_wh_ + energy_fraction_wh_) / 1000.0f; }
+  float get_total_energy() const { return (total_energy_wh_ + energy_fraction_wh_) / 1000.0f; }
+  bool has_tank() const { return tank_capacity_ml_ > 0.0f; }
+  float get_tank_remaining() const { return tank_remaining_ml_; }
+  float get_tank_level_percent() const { return has_tank() ? tank_remaining_ml_ / tank_capacity_ml_ * 100.0f : NAN; }
+  float get_tank_hours_left() const;
+  bool is_low_fuel() const { return low_fuel_; }
+  float get_pump_calibration_factor(uint8_t level) const {
+    if (level < 1 || level > CALIBRATION_BINS) return 1.0f;
+    return calibration_factor_[level - 1];
+  }
+  float get_effective_ml_per_pulse() const {
+    return injected_per_pulse_ * get_pump_calibration_factor(get_fuel_power_level()) * compensation_.injected_factor();
+  }
+  // Power level sent to the heater, the requested one derated for altitude
+  uint8_t get_max_power_level() const { return compensation_.max_power_level(); }
+  uint8_t get_effective_power_level() const { return std::min(power_level_, get_max_power_level()); }
+  
+  // Shared bus (several heaters on one UART), set by VevorBus::add_device
+  void set_bus(VevorBus *bus) { bus_ = bus; }
+  std::vector<uint8_t> build_controller_frame();
+  void handle_bus_frame(const std::vector<uint8_t> &frame);
+  void on_request_sent(uint32_t now) { latency_.mark_sent(now); }
+  
+  // Command and link latency histograms
+  const LatencyTracker &get_latency() const { return latency_; }
+  uint32_t get_bus_poll_interval() const {
+    return is_heating_or_active() || in_boot_poll_burst() ? SEND_INTERVAL_MS : polling_interval_ms_;
+  }
+  // No frame since boot yet, poll fast so restored values are replaced quickly
+  bool in_boot_poll_burst() const { return !frame_received_ && millis() - setup_time_ < BOOT_POLL_BURST_MS; }
+  BusPriority get_bus_priority() const;
   
   // Component lifecycle
   void setup() override;
   void update() override;
   void dump_config() override;
+  void on_shutdown() override;
+  void on_safe_shutdown() override;
   float get_setup_priority() const override { return setup_priority::DATA; }
 
  protected:
@@ -153,44 +530,155 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   void send_controller_frame();
   void process_heater_frame(const std::vector<uint8_t> &frame);
   void check_uart_data();
-  bool validate_frame(const std::vector<uint8_t> &frame, uint8_t expected_length);
+  void drain_uart_task();
+  void handle_received_frame(const std::vector<uint8_t> &frame, uint32_t time);
+  bool accept_frame(const std::vector<uint8_t> &frame);
+  bool is_heating_or_active() const { return controller_.is_heat_requested() || current_state_ != HeaterState::OFF; }
+  // Preference key, salted with the device ID for every heater but the default one
+  uint32_t preference_hash(const char *key) const;
   
   // Data parsing helpers
   uint16_t read_uint16_be(const std::vector<uint8_t> &data, size_t offset);
   float parse_temperature(const std::vector<uint8_t> &data, size_t offset);
   float parse_voltage(const std::vector<uint8_t> &data, size_t offset);
   const char* state_to_string(HeaterState state);
+  const char* fault_to_string(FaultCode code);
   
   // State management
   void update_sensors(const std::vector<uint8_t> &frame);
   void handle_communication_timeout();
   void check_voltage_safety();
   void handle_antifreeze_mode();
+  bool can_start_heater();
+  void on_controller_transition(ControllerState from, ControllerState to, ControllerEvent event);
+  
+  // Restart policy
+  void record_start_failure(ControllerState from, ControllerEvent event);
+  void check_start_confirmed();
+  void publish_restart_state();
+  void save_restart_policy();
+  void load_restart_policy();
+  
+  // Shutdown sequencing
+  bool is_start_deferred();
+  bool is_heat_exchanger_hot() const;
+  void update_controller_intent();
+  void load_warm_start();
+  void save_warm_start();
+  void update_warm_start();
+  uint32_t get_unix_time();
+  void update_maintenance(HeaterState old_state);
+  void publish_maintenance_state();
+  void save_maintenance();
+  void load_maintenance();
+  void save_controller_intent();
+  void load_controller_intent();
   
   // Fuel consumption tracking
   void update_fuel_consumption(float pump_frequency);
+  void mark_fuel_data_dirty(bool urgent = false);
+  void commit_pending_fuel_data(bool force = false);
+  // Queues runtime and backoff state that only reaches flash periodically, then commits
+  void commit_shutdown_data();
+  bool is_uart_idle();
   void save_fuel_consumption_data();
+  void load_energy_data();
+  void add_delivered_energy(float consumed_ml, uint8_t level);
+  void publish_energy_state();
+  void publish_compensation_state();
+  void check_latency_confirmed();
+  void publish_latency_state();
   void load_fuel_consumption_data();
+  void save_pump_calibration_data();
+  void load_pump_calibration_data();
+  bool solve_pump_calibration();
+  float compute_fuel_since_refill() const;
+  void save_fuel_tank_data();
+  void load_fuel_tank_data();
+  void update_fuel_tank(float consumed_ml, float rate_ml_h, uint8_t level, float time_seconds);
+  void publish_fuel_tank_state();
+  
+  // Schedule engine
+  void handle_schedule();
+  void rebuild_schedule_index();
+  void seek_schedule(uint16_t week_minute, bool resume);
+  void fire_schedule_event(const ScheduleEvent &event);
+  void save_schedule_data();
+  void load_schedule_data();
+  void publish_schedule_next_event();
+  void start_schedule_slot(uint8_t index);
+  // Stops a heater the slot started, or drops its pending preheat, like its stop event
+  void end_schedule_slot(uint8_t index);
+  void handle_pending_preheat(uint16_t week_minute);
+  
+  // Warm-up learning
+  void update_warmup_learning();
+  void finish_warmup_session();
+  void save_warmup_model();
+  void load_warmup_model();
+  
+  // Fault detection and log
+  void check_state_faults(HeaterState old_state, HeaterState new_state, const std::vector<uint8_t> &frame);
+  void check_frame_faults(const std::vector<uint8_t> &frame);
+  void record_fault(FaultCode code, const std::vector<uint8_t> *frame);
+  void publish_fault_state();
+  void save_fault_log();
+  void load_fault_log();
+  uint8_t get_fuel_power_level() const {
+    // Prefer the level the heater reports, the commanded one may not be applied yet
+    return (reported_power_level_ >= 1 && reported_power_level_ <= 10) ? reported_power_level_ : power_level_;
+  }
   void check_daily_reset();
   uint32_t get_days_since_epoch();
   
   // Communication state
-  std::vector<uint8_t> rx_buffer_;
+  FrameReceiver receiver_;
   uint32_t last_received_time_{0};
   uint32_t last_send_time_{0};
-  bool frame_sync_{false};
+  uint32_t last_timeout_log_{0};  // Per heater, so one silent heater does not mute another's warnings
+  VevorBus *bus_{nullptr};
+  UartTask *uart_task_{nullptr};  // Owns the UART when running, see uart_task.h
+  std::vector<uint8_t> task_frame_;
+#ifdef USE_VEVOR_UART_TASK
+  uint8_t uart_task_core_{0};
+  uint8_t uart_task_priority_{5};
+#endif
+  uint8_t device_id_{HEATER_ID};
+  bool addressed_requests_{false};  // Experimental, byte 1 of requests is CONTROLLER_ID otherwise
+  bool reject_bad_checksum_{false};  // Checksum mismatches are only logged otherwise
+  uint32_t checksum_mismatches_{0};
+  uint32_t setup_time_{0};
+  bool frame_received_{false};  // Live data since boot, restored values are stale until then
   uint32_t polling_interval_ms_{DEFAULT_POLLING_INTERVAL_MS};
   
   // Control state
-  bool heater_enabled_{false};
+  ControllerStateMachine controller_;
+  RestartPolicy restart_policy_;
+  bool start_confirmed_{false};  // Current start reached START_CONFIRM_SECONDS of stable combustion
+  uint32_t last_backoff_published_{UINT32_MAX};
+  bool restart_dirty_{false};
+  ESPPreferenceObject pref_restart_policy_;
+  float restart_temperature_{60.0f};  // Heat exchanger must cool below this before a restart
+  bool resume_after_reboot_{true};
+  bool resume_pending_{false};        // Re-assert the start once the first frame arrives
+  bool shutdown_pending_{false};
+  bool intent_heat_requested_{false};
+  bool intent_dirty_{false};
+  uint16_t cooldown_seconds_{0};
+  ESPPreferenceObject pref_controller_intent_;
+  WarmStartData warm_start_{};  // Last saved copy, compared to spot changes
+  uint32_t last_warm_start_save_{0};
+  bool warm_start_dirty_{false};
+  ControlMode configured_mode_{ControlMode::MANUAL};
+  ESPPreferenceObject pref_warm_start_;
   uint8_t power_level_{8};  // 1-10 scale, default 80%
   float target_temperature_{20.0};
   HeaterState current_state_{HeaterState::OFF};
   ControlMode control_mode_{ControlMode::MANUAL};
   float default_power_percent_{80.0};
   float injected_per_pulse_{INJECTED_PER_PULSE};
-  float min_voltage_start_{12.3f};      // Minimum voltage to allow starting
-  float min_voltage_operate_{11.4f};    // Minimum voltage to keep running
+  float min_voltage_start_{HEATER_PROFILE.min_voltage_start};      // Minimum voltage to allow starting
+  float min_voltage_operate_{HEATER_PROFILE.min_voltage_operate};  // Minimum voltage to keep running
   float antifreeze_temp_on_{2.0f};      // Temperature to turn on at 80% power
   float antifreeze_temp_medium_{6.0f};  // Temperature to set 50% power
   float antifreeze_temp_low_{8.0f};     // Temperature to set 20% power
@@ -208,6 +696,7 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   float pump_frequency_{0.0};
   float glow_plug_current_{0.0};
   uint16_t state_duration_{0};
+  uint8_t reported_power_level_{0};
   bool cooling_down_{false};
   bool low_voltage_error_{false};
   
@@ -220,12 +709,136 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   float total_consumption_ml_{0.0};  // Lifetime total consumption
   ESPPreferenceObject pref_fuel_consumption_;
   
+  // Energy accounting, derived from the same calibrated fuel flow
+  float heating_value_{DEFAULT_HEATING_VALUE};
+  float heater_efficiency_[CALIBRATION_BINS]{
+      DEFAULT_HEATER_EFFICIENCY, DEFAULT_HEATER_EFFICIENCY, DEFAULT_HEATER_EFFICIENCY, DEFAULT_HEATER_EFFICIENCY,
+      DEFAULT_HEATER_EFFICIENCY, DEFAULT_HEATER_EFFICIENCY, DEFAULT_HEATER_EFFICIENCY, DEFAULT_HEATER_EFFICIENCY,
+      DEFAULT_HEATER_EFFICIENCY, DEFAULT_HEATER_EFFICIENCY};
+  uint32_t daily_energy_wh_{0};
+  uint32_t total_energy_wh_{0};
+  float energy_fraction_wh_{0.0f};
+  ESPPreferenceObject pref_energy_;
+  
+  // Deferred fuel persistence - frame processing only snapshots, flash commit happens in an idle slot
+  FuelConsumptionData fuel_snapshot_[2]{};
+  EnergyData energy_snapshot_[2]{};     // Flipped together with fuel_snapshot_
+  uint8_t fuel_snapshot_index_{0};      // Buffer holding the latest complete snapshot
+  bool fuel_data_dirty_{false};
+  bool fuel_commit_urgent_{false};      // Commit at the next idle slot regardless of window
+  uint32_t fuel_dirty_since_{0};        // Time of the first uncommitted change
+  uint32_t fuel_save_interval_ms_{DEFAULT_FUEL_SAVE_INTERVAL_MS};
+  
+  // Pump calibration learned from refills
+  float calibration_factor_[CALIBRATION_BINS]{1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+  float calibration_normal_matrix_[CALIBRATION_BINS * (CALIBRATION_BINS + 1) / 2]{};
+  float calibration_normal_vector_[CALIBRATION_BINS]{};
+  float refill_pulses_[CALIBRATION_BINS]{};
+  uint16_t refill_events_{0};
+  float refill_volume_ml_{0.0f};
+  float fuel_since_refill_ml_{0.0f};
+  bool calibration_dirty_{false};
+  ESPPreferenceObject pref_pump_calibration_;
+  
+  // Fuel tank model
+  float tank_capacity_ml_{0.0f};        // 0 = no tank configured
+  float tank_remaining_ml_{0.0f};
+  float burn_rate_ml_h_[CALIBRATION_BINS]{};
+  float low_fuel_threshold_percent_{10.0f};
+  bool low_fuel_shutdown_{false};
+  bool low_fuel_{false};
+  bool tank_dirty_{false};
+  ESPPreferenceObject pref_fuel_tank_;
+  
+  // Schedule engine state
+  ScheduleSlot schedule_slots_[MAX_SCHEDULE_SLOTS]{};
+  ScheduleEvent schedule_events_[MAX_SCHEDULE_SLOTS * 7 * 2];
+  uint8_t schedule_event_count_{0};
+  uint8_t schedule_next_event_{0};       // Index of the next event to fire
+  uint16_t schedule_last_minute_{SCHEDULE_MINUTE_INVALID};
+  uint8_t schedule_active_slot_{SCHEDULE_SLOT_NONE};  // Slot that turned the heater on
+  uint32_t schedule_config_hash_{0};
+  bool schedule_enabled_{true};
+  uint8_t schedule_pending_slot_{SCHEDULE_SLOT_NONE};  // Auto preheat slot waiting for its start
+  uint16_t schedule_pending_window_{0};                // Minute of week its preheat window opened
+  bool schedule_dirty_{false};
+  ESPPreferenceObject pref_schedule_;
+  
+  // Warm-up learning state
+  WarmupStats warmup_stats_[10]{};
+  float startup_minutes_{5.0f};
+  bool warmup_was_enabled_{false};
+  uint32_t warmup_enabled_at_{0};
+  bool warmup_startup_measured_{true};
+  bool warmup_session_active_{false};
+  uint32_t warmup_session_start_{0};
+  float warmup_start_temp_{NAN};
+  uint8_t warmup_level_{0};
+  float preheat_lead_minutes_{NAN};
+  uint32_t last_preheat_publish_{0};
+  bool warmup_dirty_{false};
+  ESPPreferenceObject pref_warmup_model_;
+  
+  // Fault log state
+  FaultLogEntry fault_log_[FAULT_LOG_SIZE]{};
+  uint16_t fault_counts_[FAULT_CODE_COUNT]{};
+  uint8_t fault_log_head_{0};
+  uint8_t fault_log_size_{0};
+  FaultCode last_fault_{FaultCode::NONE};
+  float overheat_temperature_{HEATER_PROFILE.overheat_temperature};
+  bool overheat_active_{false};
+  uint8_t pump_fault_frames_{0};
+  bool communication_fault_active_{false};
+  uint8_t last_state_raw_{0};
+  bool fault_log_dirty_{false};
+  ESPPreferenceObject pref_fault_log_;
+  
+  // Maintenance counters
+  MaintenanceData maintenance_{};
+  uint32_t maintenance_remainder_ms_{0};  // Runtime below a whole second, RAM only
+  uint32_t maintenance_unsaved_s_{0};     // Runtime not yet queued for flash
+  uint32_t last_maintenance_frame_{0};
+  uint32_t service_interval_seconds_{0};  // 0 disables the burner hours threshold
+  uint32_t service_interval_ignitions_{0};
+  bool service_due_{false};
+  bool maintenance_dirty_{false};
+  ESPPreferenceObject pref_maintenance_;
+  
+  // Distinct status frames and per-byte statistics, allocated only while enabled
+  FrameCapture frame_capture_;
+  uint16_t frame_capture_capacity_{DEFAULT_CAPTURE_CAPACITY};
+  
+  // One request status for fleet monitoring
+  StatusSnapshot status_snapshot_;
+#ifdef USE_VEVOR_STATUS_ENDPOINT
+  web_server_base::WebServerBase *status_web_base_{nullptr};
+  std::string status_path_;
+#endif
+#ifdef USE_VEVOR_MQTT_TELEMETRY
+  void check_telemetry();
+  std::string telemetry_topic_;
+  uint32_t telemetry_interval_ms_{60000};
+  bool telemetry_on_state_change_{true};
+  uint32_t last_telemetry_publish_{0};
+  uint32_t telemetry_sequence_{0};
+  uint8_t telemetry_heater_state_{0xFF};
+  uint8_t telemetry_controller_state_{0xFF};
+#endif
+  
   // Time component pointer
   time::RealTimeClock *time_component_{nullptr};
   bool time_sync_warning_shown_{false};
   
   // Sensor pointers - removed duplicate temperature_sensor_
-  sensor::Sensor *external_temperature_sensor_{nullptr};
+  TemperatureAggregator temperature_inputs_;
+  Compensation compensation_;
+  uint8_t last_max_power_level_{0};  // Logged and published on change
+  float last_effective_ml_per_pulse_{NAN};
+  LatencyTracker latency_;
+  bool latency_start_{false};  // Pending intent is a start, else a stop
+  uint32_t last_latency_publish_{0};
+  uint32_t latency_published_counts_[LATENCY_METRIC_COUNT]{};
+  sensor::Sensor *latency_sensors_[LATENCY_METRIC_COUNT][LATENCY_STAT_COUNT]{};
   sensor::Sensor *input_voltage_sensor_{nullptr};
   text_sensor::TextSensor *state_sensor_{nullptr};
   sensor::Sensor *power_level_sensor_{nullptr};
@@ -239,6 +852,31 @@ class VevorHeater : public PollingComponent, public uart::UARTDevice {
   sensor::Sensor *daily_consumption_sensor_{nullptr};
   sensor::Sensor *total_consumption_sensor_{nullptr};
   binary_sensor::BinarySensor *low_voltage_error_sensor_{nullptr};
+  sensor::Sensor *fuel_since_refill_sensor_{nullptr};
+  sensor::Sensor *thermal_power_sensor_{nullptr};
+  sensor::Sensor *daily_energy_sensor_{nullptr};
+  sensor::Sensor *total_energy_sensor_{nullptr};
+  sensor::Sensor *effective_max_power_sensor_{nullptr};
+  sensor::Sensor *effective_injected_per_pulse_sensor_{nullptr};
+  sensor::Sensor *tank_remaining_sensor_{nullptr};
+  sensor::Sensor *tank_level_sensor_{nullptr};
+  sensor::Sensor *tank_hours_left_sensor_{nullptr};
+  binary_sensor::BinarySensor *low_fuel_sensor_{nullptr};
+  text_sensor::TextSensor *schedule_next_event_sensor_{nullptr};
+  sensor::Sensor *preheat_lead_time_sensor_{nullptr};
+  sensor::Sensor *fault_count_sensor_{nullptr};
+  text_sensor::TextSensor *last_fault_sensor_{nullptr};
+  text_sensor::TextSensor *controller_state_sensor_{nullptr};
+  sensor::Sensor *failed_starts_sensor_{nullptr};
+  sensor::Sensor *restart_backoff_sensor_{nullptr};
+  binary_sensor::BinarySensor *restart_lockout_sensor_{nullptr};
+  sensor::Sensor *burner_hours_sensor_{nullptr};
+  sensor::Sensor *fan_hours_sensor_{nullptr};
+  sensor::Sensor *ignition_count_sensor_{nullptr};
+  sensor::Sensor *burner_hours_since_service_sensor_{nullptr};
+  sensor::Sensor *ignitions_since_service_sensor_{nullptr};
+  binary_sensor::BinarySensor *service_due_sensor_{nullptr};
+  sensor::Sensor *cooldown_time_sensor_{nullptr};
   number::Number *injected_per_pulse_number_{nullptr};
 };
 
@@ -280,6 +918,132 @@ class VevorResetTotalConsumptionButton : public button::Button, public Component
   VevorHeater *heater_{nullptr};
 };
 
+// Number component for entering a measured refill volume
+class VevorRefillVolumeNumber : public number::Number, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+ protected:
+  void control(float value) override {
+    if (heater_) {
+      heater_->set_refill_volume(value);
+      this->publish_state(value);
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
+// Button component for clearing the fault log
+class VevorClearFaultLogButton : public button::Button, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+ protected:
+  void press_action() override {
+    if (heater_) {
+      heater_->clear_fault_log();
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
+// Button component for recording a service, restarts the since-service counters
+class VevorServiceResetButton : public button::Button, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+ protected:
+  void press_action() override {
+    if (heater_) {
+      heater_->reset_service_counters();
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
+// Button component for clearing a lockout and the failed start counter
+class VevorResetLockoutButton : public button::Button, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+ protected:
+  void press_action() override {
+    if (heater_) {
+      heater_->reset_controller();
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
+// Switch component for raw frame capture
+class VevorFrameCaptureSwitch : public switch_::Switch, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+  void setup() override {
+    this->publish_state(false);
+  }
+  
+ protected:
+  void write_state(bool state) override {
+    if (heater_) {
+      heater_->set_frame_capture_enabled(state);
+      this->publish_state(state);
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
+// Button component for dumping captured frames and statistics to the log
+class VevorDumpFrameCaptureButton : public button::Button, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+ protected:
+  void press_action() override {
+    if (heater_) {
+      heater_->dump_frame_capture();
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
+// Button component for marking the fuel tank as full
+class VevorRefillTankButton : public button::Button, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+ protected:
+  void press_action() override {
+    if (heater_) {
+      heater_->refill_tank();
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
+// Button component for logging a refill with the entered volume
+class VevorLogRefillButton : public button::Button, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+ protected:
+  void press_action() override {
+    if (heater_) {
+      heater_->log_refill(heater_->get_refill_volume());
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
 // Switch component for heater power control (Manual mode only)
 class VevorHeaterPowerSwitch : public switch_::Switch, public Component {
  public:
@@ -301,7 +1065,8 @@ class VevorHeaterPowerSwitch : public switch_::Switch, public Component {
       } else {
         heater_->turn_off();
       }
-      this->publish_state(state);
+      // A refused start (lockout, low voltage, low fuel) leaves the switch off
+      this->publish_state(heater_->is_heater_enabled());
     }
   }
   
@@ -336,6 +1101,28 @@ class VevorHeaterPowerLevelNumber : public number::Number, public Component {
   VevorHeater *heater_{nullptr};
 };
 
+// Switch component for enabling the on-device schedule
+class VevorScheduleSwitch : public switch_::Switch, public Component {
+ public:
+  void set_vevor_heater(VevorHeater *heater) { heater_ = heater; }
+  
+  void setup() override {
+    if (heater_) {
+      this->publish_state(heater_->is_schedule_enabled());
+    }
+  }
+  
+ protected:
+  void write_state(bool state) override {
+    if (heater_) {
+      heater_->set_schedule_enabled(state);
+      this->publish_state(state);
+    }
+  }
+  
+  VevorHeater *heater_{nullptr};
+};
+
 // Select component for control mode
 class VevorControlModeSelect : public select::Select, public Component {
  public:
@@ -371,5 +1158,27 @@ class VevorControlModeSelect : public select::Select, public Component {
   VevorHeater *heater_{nullptr};
 };
 
+#ifdef USE_VEVOR_STATUS_ENDPOINT
+// GET handler serving the cached status snapshot
+class VevorStatusHandler : public AsyncWebHandler {
+ public:
+  VevorStatusHandler(VevorHeater *heater, const std::string &path) : heater_(heater), path_(path) {}
+  
+  bool canHandle(AsyncWebServerRequest *request) const override {
+    return request->method() == HTTP_GET && request->url() == path_.c_str();
+  }
+  // Runs on the web server task, the snapshot hands out a copy built under its lock
+  void handleRequest(AsyncWebServerRequest *request) override {
+    std::string json = heater_->get_status_json();
+    request->send(200, "application/json", json.c_str());
+  }
+  bool isRequestHandlerTrivial() const override { return false; }
+  
+ protected:
+  VevorHeater *heater_;
+  std::string path_;
+};
+#endif
+
 }  // namespace vevor_heater
 }  // namespace esphome
\ No newline at end of file
@@ -0,0 +1,170 @@
+// Shared bus slot arbitration driven with simulated timestamps: guard time, slot
+// timeouts, reply matching, priority order and aging under a saturated line.
+#include "bus_scheduler.h"
+#include <cstdio>
+
+using namespace esphome::vevor_heater;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if (!(cond)) { \
+      failures++; \
+      std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+      std::printf(__VA_ARGS__); \
+      std::printf("\n"); \
+    } \
+  } while (0)
+
+const int NO_SLOT = BusScheduler::NO_SLOT;
+
+void test_slots() {
+  BusScheduler scheduler;
+  scheduler.add_device(0x77);
+  scheduler.add_device(0x78);
+  scheduler.start(1000);
+  std::vector<BusDeviceState> states = {{BusPriority::IDLE, 1000}, {BusPriority::IDLE, 1000}};
+
+  // Guard time after start, and no slot while a frame is arriving
+  CHECK(!scheduler.can_open_slot(1000 + BUS_GUARD_TIME_MS - 1, false), "slot opened inside the guard time");
+  CHECK(!scheduler.can_open_slot(1000 + BUS_GUARD_TIME_MS, true), "slot opened while the line is busy");
+  CHECK(scheduler.can_open_slot(1000 + BUS_GUARD_TIME_MS, false), "slot not opened after the guard time");
+
+  // Never polled devices go first, in order
+  uint32_t now = 1020;
+  int next = scheduler.select_next_device(now, states);
+  CHECK(next == 0, "first device %d", next);
+  scheduler.open_slot(next, now);
+  CHECK(scheduler.slot_open() && !scheduler.can_open_slot(now + 100, false), "second slot opened");
+
+  // Reply in its slot closes it and records the latency
+  bool late = true;
+  CHECK(scheduler.handle_reply(0x77, now + 240, &late) == 0 && !late, "reply not matched to its slot");
+  CHECK(!scheduler.slot_open(), "slot still open after the reply");
+  CHECK(!scheduler.can_open_slot(now + 240 + BUS_GUARD_TIME_MS - 1, false), "no guard time after a reply");
+  const BusLinkStats &stats = scheduler.stats(0);
+  CHECK(stats.requests == 1 && stats.responses == 1 && stats.last_latency_ms == 240 && stats.max_latency_ms == 240,
+        "stats after a reply: %u/%u, %u ms", (unsigned) stats.requests, (unsigned) stats.responses,
+        (unsigned) stats.last_latency_ms);
+
+  now += 240 + BUS_GUARD_TIME_MS;
+  next = scheduler.select_next_device(now, states);
+  CHECK(next == 1, "never polled device not next: %d", next);
+  scheduler.open_slot(next, now);
+
+  // Nobody answers: the slot closes after the timeout
+  CHECK(scheduler.check_timeout(now + DEFAULT_BUS_SLOT_TIMEOUT_MS - 1) == NO_SLOT, "slot closed early");
+  CHECK(scheduler.check_timeout(now + DEFAULT_BUS_SLOT_TIMEOUT_MS) == 1, "slot not timed out");
+  CHECK(scheduler.stats(1).timeouts == 1 && !scheduler.slot_open(), "timeout not counted");
+
+  // The reply arrives afterwards: delivered, counted as late, no latency
+  now += DEFAULT_BUS_SLOT_TIMEOUT_MS + 50;
+  CHECK(scheduler.handle_reply(0x78, now, &late) == 1 && late, "late reply not flagged");
+  CHECK(scheduler.stats(1).late_responses == 1 && scheduler.stats(1).responses == 0, "late reply counted as a response");
+
+  // Unknown device
+  CHECK(scheduler.handle_reply(0x79, now, &late) == NO_SLOT && scheduler.unknown_frames() == 1, "unknown device");
+
+  // Both polled within their interval: nobody is due
+  CHECK(scheduler.select_next_device(1500, states) == NO_SLOT, "device polled before its interval");
+}
+
+void test_priority() {
+  BusScheduler scheduler;
+  for (uint8_t id = 0x77; id < 0x7A; id++) {
+    scheduler.add_device(id);
+  }
+  uint32_t now = 0;
+  for (int i = 0; i < 3; i++) {
+    scheduler.open_slot(i, now);
+    bool late;
+    scheduler.handle_reply(scheduler.device_id(i), now, &late);
+  }
+
+  // All due by the same margin: transitional before active before idle
+  now = 1100;
+  std::vector<BusDeviceState> states = {
+      {BusPriority::IDLE, 1000}, {BusPriority::ACTIVE, 1000}, {BusPriority::TRANSITIONAL, 1000}};
+  CHECK(scheduler.select_next_device(now, states) == 2, "transitional device not first");
+  states[2].priority = BusPriority::IDLE;
+  CHECK(scheduler.select_next_device(now, states) == 1, "active device not before idle ones");
+
+  // Same class: the most overdue one
+  states = {{BusPriority::ACTIVE, 1000}, {BusPriority::ACTIVE, 900}, {BusPriority::ACTIVE, 1050}};
+  CHECK(scheduler.select_next_device(now, states) == 1, "most overdue device not first");
+
+  // Aging: an idle device a whole interval late beats a barely due transitional one
+  states = {{BusPriority::IDLE, 500}, {BusPriority::ACTIVE, 5000}, {BusPriority::TRANSITIONAL, 1000}};
+  CHECK(scheduler.select_next_device(now, states) == 0, "overdue idle device not promoted");
+}
+
+// Four heaters on one line asking for 5.5 polls a second while a slot with its
+// 240 ms reply fits 3.8 into a second: the line is saturated, yet the idle heater
+// is still polled. The two transitional heaters alone would fill the line, so without
+// aging the others would starve
+void test_saturated_bus() {
+  BusScheduler scheduler;
+  std::vector<BusDeviceState> states = {{BusPriority::TRANSITIONAL, 500},
+                                        {BusPriority::TRANSITIONAL, 500},
+                                        {BusPriority::ACTIVE, 1000},
+                                        {BusPriority::IDLE, 2000}};
+  for (uint8_t id = 0x77; id < 0x7B; id++) {
+    scheduler.add_device(id);
+  }
+  scheduler.start(0);
+
+  static const uint32_t DURATION_MS = 600000;
+  static const uint32_t REPLY_MS = 240;
+  uint32_t last_poll[4] = {0, 0, 0, 0};
+  uint32_t max_gap[4] = {0, 0, 0, 0};
+  uint32_t reply_at = 0;
+  for (uint32_t now = 0; now < DURATION_MS; now++) {
+    if (scheduler.slot_open() && now == reply_at) {
+      bool late;
+      scheduler.handle_reply(scheduler.device_id(scheduler.slot_device()), now, &late);
+    }
+    scheduler.check_timeout(now);
+    if (scheduler.can_open_slot(now, false)) {
+      int next = scheduler.select_next_device(now, states);
+      if (next != NO_SLOT) {
+        if (now - last_poll[next] > max_gap[next]) {
+          max_gap[next] = now - last_poll[next];
+        }
+        last_poll[next] = now;
+        scheduler.open_slot(next, now);
+        reply_at = now + REPLY_MS;
+      }
+    }
+  }
+
+  for (size_t i = 0; i < 4; i++) {
+    const BusLinkStats &stats = scheduler.stats(i);
+    // The last slot may still be waiting for its reply
+    uint32_t pending = scheduler.slot_device() == static_cast<int>(i) ? 1 : 0;
+    CHECK(stats.timeouts == 0 && stats.responses + pending == stats.requests, "device %u: %u requests, %u responses",
+          (unsigned) i, (unsigned) stats.requests, (unsigned) stats.responses);
+    // Nobody waits more than two intervals plus a slot
+    uint32_t limit = 2 * states[i].poll_interval_ms + REPLY_MS + BUS_GUARD_TIME_MS;
+    CHECK(max_gap[i] <= limit, "device %u waited %u ms, limit %u ms", (unsigned) i, (unsigned) max_gap[i],
+          (unsigned) limit);
+    std::printf("bus scheduler: device %u polled %u times, longest gap %u ms\n", (unsigned) i,
+                (unsigned) stats.requests, (unsigned) max_gap[i]);
+  }
+}
+
+}  // namespace
+
+int main() {
+  test_slots();
+  test_priority();
+  test_saturated_bus();
+  if (failures > 0) {
+    std::printf("%d checks failed\n", failures);
+    return 1;
+  }
+  std::printf("bus_scheduler: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,213 @@
+// Walks every (state, event) pair of the controller transition table for every guard
+// input (previous heater phase, restart latch, start permission), and every (state,
+// heater phase) pair of the request table, against the tables below.
+#include "controller_state.h"
+#include <cstdio>
+
+using namespace esphome::vevor_heater;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if (!(cond)) { \
+      failures++; \
+      std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+      std::printf(__VA_ARGS__); \
+      std::printf("\n"); \
+    } \
+  } while (0)
+
+// Sets any state, heater phase and latch without going through the table
+class TestMachine : public ControllerStateMachine {
+ public:
+  void set(ControllerState state, ControllerEvent phase, bool latched) {
+    state_ = state;
+    heater_phase_ = phase;
+    latched_ = latched;
+  }
+};
+
+using S = ControllerState;
+using E = ControllerEvent;
+using R = ControllerRequest;
+
+enum class Guard { NONE, START_PERMITTED, WAS_ACTIVE, REJECT, NOT_LATCHED };
+
+struct Expected {
+  S next;
+  Guard guard;
+};
+
+const Guard N = Guard::NONE;
+
+// Columns: START, STOP, HEATER_OFF, HEATER_IGNITING, HEATER_RUNNING, HEATER_COOLING, LOW_VOLTAGE, VOLTAGE_OK,
+// RESET, RESTART_LIMIT
+const Expected TRANSITIONS[CONTROLLER_STATE_COUNT][CONTROLLER_EVENT_COUNT] = {
+    // IDLE
+    {{S::STARTING, Guard::START_PERMITTED}, {S::IDLE, N}, {S::IDLE, N}, {S::STOPPING, N}, {S::STOPPING, N},
+     {S::STOPPING, N}, {S::IDLE, N}, {S::IDLE, N}, {S::IDLE, N}, {S::LOCKOUT, N}},
+    // STARTING
+    {{S::STARTING, N}, {S::STOPPING, N}, {S::FAULT, Guard::WAS_ACTIVE}, {S::STARTING, N}, {S::RUNNING, N},
+     {S::FAULT, Guard::WAS_ACTIVE}, {S::LOCKOUT, N}, {S::STARTING, N}, {S::STARTING, N}, {S::LOCKOUT, N}},
+    // RUNNING
+    {{S::RUNNING, N}, {S::STOPPING, N}, {S::FAULT, N}, {S::STARTING, N}, {S::RUNNING, N}, {S::FAULT, N},
+     {S::LOCKOUT, N}, {S::RUNNING, N}, {S::RUNNING, N}, {S::LOCKOUT, N}},
+    // STOPPING
+    {{S::STARTING, Guard::START_PERMITTED}, {S::STOPPING, N}, {S::IDLE, N}, {S::STOPPING, N}, {S::STOPPING, N},
+     {S::STOPPING, N}, {S::STOPPING, N}, {S::STOPPING, N}, {S::STOPPING, N}, {S::LOCKOUT, N}},
+    // LOCKOUT
+    {{S::LOCKOUT, Guard::REJECT}, {S::LOCKOUT, N}, {S::LOCKOUT, N}, {S::LOCKOUT, N}, {S::LOCKOUT, N},
+     {S::LOCKOUT, N}, {S::LOCKOUT, N}, {S::IDLE, Guard::NOT_LATCHED}, {S::IDLE, N}, {S::LOCKOUT, N}},
+    // FAULT
+    {{S::STARTING, Guard::START_PERMITTED}, {S::STOPPING, N}, {S::FAULT, N}, {S::FAULT, N}, {S::FAULT, N},
+     {S::FAULT, N}, {S::FAULT, N}, {S::FAULT, N}, {S::IDLE, N}, {S::LOCKOUT, N}},
+};
+
+// Columns: heater phase OFF, IGNITING, RUNNING, COOLING
+const R REQUESTS[CONTROLLER_STATE_COUNT][4] = {
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // IDLE
+    {R::START, R::RUN, R::RUN, R::RUN},        // STARTING
+    {R::START, R::RUN, R::RUN, R::RUN},        // RUNNING
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // STOPPING
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // LOCKOUT
+    {R::STATUS, R::STOP, R::STOP, R::STATUS},  // FAULT
+};
+
+const E PHASES[] = {E::HEATER_OFF, E::HEATER_IGNITING, E::HEATER_RUNNING, E::HEATER_COOLING};
+
+bool is_heater_event(E event) { return event >= E::HEATER_OFF && event <= E::HEATER_COOLING; }
+
+bool guard_passes(Guard guard, E phase, bool latched, bool start_permitted) {
+  switch (guard) {
+    case Guard::NONE: return true;
+    case Guard::START_PERMITTED: return start_permitted;
+    case Guard::WAS_ACTIVE: return phase == E::HEATER_IGNITING || phase == E::HEATER_RUNNING;
+    case Guard::NOT_LATCHED: return !latched;
+    default: return false;
+  }
+}
+
+const char *state_name(S state) { return ControllerStateMachine::state_to_string(state); }
+const char *event_name(E event) { return ControllerStateMachine::event_to_string(event); }
+
+void test_transitions() {
+  for (uint8_t s = 0; s < CONTROLLER_STATE_COUNT; s++) {
+    for (uint8_t e = 0; e < CONTROLLER_EVENT_COUNT; e++) {
+      for (E phase : PHASES) {
+        for (int latched = 0; latched < 2; latched++) {
+          for (int permitted = 0; permitted < 2; permitted++) {
+            S state = static_cast<S>(s);
+            E event = static_cast<E>(e);
+            const Expected &expected = TRANSITIONS[s][e];
+            bool accepted = guard_passes(expected.guard, phase, latched, permitted);
+            S next = accepted ? expected.next : state;
+
+            TestMachine machine;
+            machine.set(state, phase, latched);
+            machine.set_start_guard([permitted]() { return permitted != 0; });
+            int calls = 0;
+            machine.set_transition_callback([&](S from, S to, E by) {
+              calls++;
+              CHECK(from == state && to == next && by == event, "%s + %s: callback %s -> %s (%s)", state_name(state),
+                    event_name(event), state_name(from), state_name(to), event_name(by));
+            });
+
+            bool result = machine.dispatch(event);
+            const char *ctx_state = state_name(state);
+            const char *ctx_event = event_name(event);
+            CHECK(result == accepted, "%s + %s (phase %s, latched %d, permitted %d): returned %d", ctx_state,
+                  ctx_event, event_name(phase), latched, permitted, result);
+            CHECK(machine.state() == next, "%s + %s (phase %s, latched %d, permitted %d): state %s, expected %s",
+                  ctx_state, ctx_event, event_name(phase), latched, permitted, state_name(machine.state()),
+                  state_name(next));
+            CHECK(calls == (next != state ? 1 : 0), "%s + %s: %d callbacks", ctx_state, ctx_event, calls);
+
+            // Heater phase and latch are tracked whether or not the event was accepted
+            E expected_phase = is_heater_event(event) ? event : phase;
+            bool expected_latch = event == E::RESTART_LIMIT ? true : event == E::RESET ? false : latched != 0;
+            CHECK(machine.heater_phase() == expected_phase, "%s + %s: heater phase %s", ctx_state, ctx_event,
+                  event_name(machine.heater_phase()));
+            CHECK(machine.is_latched() == expected_latch, "%s + %s: latched %d", ctx_state, ctx_event,
+                  machine.is_latched());
+          }
+        }
+      }
+    }
+  }
+}
+
+void test_requests() {
+  for (uint8_t s = 0; s < CONTROLLER_STATE_COUNT; s++) {
+    for (uint8_t p = 0; p < 4; p++) {
+      TestMachine machine;
+      machine.set(static_cast<S>(s), PHASES[p], false);
+      CHECK(machine.request() == REQUESTS[s][p], "%s in phase %s: request %d", state_name(static_cast<S>(s)),
+            event_name(PHASES[p]), static_cast<int>(machine.request()));
+    }
+  }
+}
+
+void test_lockout_latch() {
+  // A low voltage stop while running locks out until the supply recovers
+  ControllerStateMachine machine;
+  machine.dispatch(E::START_REQUEST);
+  machine.dispatch(E::HEATER_RUNNING);
+  machine.dispatch(E::LOW_VOLTAGE);
+  CHECK(machine.state() == S::LOCKOUT, "low voltage: %s", state_name(machine.state()));
+  CHECK(!machine.dispatch(E::START_REQUEST), "start accepted in lockout");
+  CHECK(machine.dispatch(E::VOLTAGE_OK) && machine.state() == S::IDLE, "voltage ok: %s", state_name(machine.state()));
+
+  // The restart limit latches: recovered voltage is refused, only RESET clears it
+  machine.dispatch(E::RESTART_LIMIT);
+  CHECK(machine.is_locked_out() && machine.is_latched(), "restart limit did not latch");
+  CHECK(!machine.dispatch(E::VOLTAGE_OK) && machine.state() == S::LOCKOUT, "voltage ok cleared a latched lockout");
+  machine.dispatch(E::LOW_VOLTAGE);
+  CHECK(!machine.dispatch(E::VOLTAGE_OK) && machine.is_latched(), "latch lost on low voltage");
+  CHECK(machine.dispatch(E::RESET) && machine.state() == S::IDLE && !machine.is_latched(), "reset: %s",
+        state_name(machine.state()));
+  CHECK(machine.dispatch(E::START_REQUEST) && machine.state() == S::STARTING, "start after reset: %s",
+        state_name(machine.state()));
+}
+
+void test_restart_policy() {
+  RestartPolicy policy;
+  policy.set_max_failures(3);
+  policy.set_base_backoff(1000);
+  policy.set_max_backoff(3000);
+  CHECK(policy.backoff_remaining(0) == 0, "backoff without failures");
+  CHECK(!policy.record_failure(100), "limit after one failure");
+  CHECK(policy.backoff_remaining(600) == 500, "first backoff %u", (unsigned) policy.backoff_remaining(600));
+  CHECK(!policy.record_failure(2000), "limit after two failures");
+  CHECK(policy.backoff_remaining(2000) == 2000, "second backoff %u", (unsigned) policy.backoff_remaining(2000));
+  CHECK(policy.record_failure(5000), "no limit after three failures");
+  CHECK(policy.backoff_remaining(5000) == 3000, "capped backoff %u", (unsigned) policy.backoff_remaining(5000));
+  CHECK(policy.backoff_remaining(9000) == 0, "backoff did not expire");
+  policy.record_success();
+  CHECK(policy.failures() == 0 && policy.backoff_remaining(5000) == 0, "success kept the backoff");
+
+  // Restored after a reboot: the saved remainder counts from the restore
+  policy.restore(2, 1500, 10000);
+  CHECK(policy.failures() == 2 && policy.backoff_remaining(10000) == 1500, "restored backoff %u",
+        (unsigned) policy.backoff_remaining(10000));
+  CHECK(policy.backoff_remaining(11000) == 500 && policy.backoff_remaining(11500) == 0, "restored backoff did not run");
+  policy.restore(0, 1500, 0);
+  CHECK(policy.backoff_remaining(0) == 0, "backoff restored without failures");
+}
+
+}  // namespace
+
+int main() {
+  test_transitions();
+  test_requests();
+  test_lockout_latch();
+  test_restart_policy();
+  if (failures > 0) {
+    std::printf("%d checks failed\n", failures);
+    return 1;
+  }
+  std::printf("controller_state: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,137 @@
+// Frame validation and reassembly from a byte stream: echoes, line noise, truncated
+// frames and corrupted checksums.
+#include "frame_receiver.h"
+#include <cstdio>
+
+using namespace esphome::vevor_heater;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if (!(cond)) { \
+      failures++; \
+      std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+      std::printf(__VA_ARGS__); \
+      std::printf("\n"); \
+    } \
+  } while (0)
+
+std::vector<uint8_t> make_frame(uint8_t id, uint8_t length, uint8_t fill) {
+  std::vector<uint8_t> frame(length + 5, fill);
+  frame[0] = FRAME_START;
+  frame[1] = id;
+  frame[2] = 0x02;
+  frame[3] = length;
+  frame.back() = calculate_checksum(frame);
+  return frame;
+}
+
+// Feeds bytes 2 ms apart and collects every completed frame
+std::vector<std::vector<uint8_t>> receive(const std::vector<uint8_t> &stream) {
+  std::vector<std::vector<uint8_t>> frames;
+  FrameReceiver receiver;
+  uint32_t now = 0;
+  for (uint8_t byte : stream) {
+    now += 2;
+    if (receiver.feed(byte, now)) {
+      frames.push_back(receiver.frame());
+      receiver.reset();
+    }
+  }
+  return frames;
+}
+
+void test_validate_frame() {
+  std::vector<uint8_t> heater = make_frame(HEATER_ID, HEATER_FRAME_LENGTH, 0x11);
+  std::vector<uint8_t> controller = make_frame(CONTROLLER_ID, CONTROLLER_FRAME_LENGTH, 0x00);
+  CHECK(validate_frame(heater) == FrameError::NONE, "heater frame rejected");
+  CHECK(validate_frame(controller) == FrameError::NONE, "controller frame rejected");
+  CHECK(validate_frame({}) == FrameError::START, "empty frame accepted");
+
+  std::vector<uint8_t> frame = heater;
+  frame[0] = 0x55;
+  CHECK(validate_frame(frame) == FrameError::START, "bad start byte: %s", frame_error_to_string(validate_frame(frame)));
+
+  // The size must be the one the length byte implies, whatever the frame holds
+  frame = heater;
+  frame.pop_back();
+  CHECK(validate_frame(frame) == FrameError::LENGTH, "truncated frame: %s", frame_error_to_string(validate_frame(frame)));
+  frame = heater;
+  frame[3] = CONTROLLER_FRAME_LENGTH;
+  frame.back() = calculate_checksum(frame);
+  CHECK(validate_frame(frame) == FrameError::LENGTH, "length byte mismatch: %s",
+        frame_error_to_string(validate_frame(frame)));
+  CHECK(validate_frame({FRAME_START, HEATER_ID, 0x02}) == FrameError::LENGTH, "frame without length byte accepted");
+
+  frame = heater;
+  frame[20] ^= 0x04;
+  CHECK(validate_frame(frame) == FrameError::CHECKSUM, "corrupted payload: %s",
+        frame_error_to_string(validate_frame(frame)));
+}
+
+void test_receiver() {
+  std::vector<uint8_t> heater = make_frame(HEATER_ID, HEATER_FRAME_LENGTH, 0x11);
+  std::vector<uint8_t> controller = make_frame(CONTROLLER_ID, CONTROLLER_FRAME_LENGTH, 0x00);
+
+  // Echo of our request followed by the reply
+  std::vector<uint8_t> stream = controller;
+  stream.insert(stream.end(), heater.begin(), heater.end());
+  auto frames = receive(stream);
+  CHECK(frames.size() == 2 && frames[0] == controller && frames[1] == heater, "echo and reply: %u frames",
+        (unsigned) frames.size());
+
+  // Noise, including a false start byte, ahead of the reply
+  stream = {0x13, FRAME_START, 0x00, FRAME_START, HEATER_ID, 0x9C};
+  stream.insert(stream.end(), heater.begin(), heater.end());
+  frames = receive(stream);
+  CHECK(frames.size() == 1 && frames[0] == heater, "noise then reply: %u frames", (unsigned) frames.size());
+
+  // A truncated frame is abandoned for the one that starts inside it
+  stream.assign(heater.begin(), heater.begin() + 30);
+  stream.insert(stream.end(), controller.begin(), controller.end());
+  frames = receive(stream);
+  CHECK(frames.size() == 1 && frames[0] == controller, "truncated then controller: %u frames",
+        (unsigned) frames.size());
+
+  // A corrupted frame still completes, and validate_frame rejects it
+  stream = heater;
+  stream[20] ^= 0x04;
+  frames = receive(stream);
+  CHECK(frames.size() == 1 && validate_frame(frames[0]) == FrameError::CHECKSUM, "corrupted frame: %u frames",
+        (unsigned) frames.size());
+
+  // A gap drops the partial frame
+  FrameReceiver receiver;
+  receiver.feed(FRAME_START, 0);
+  receiver.feed(HEATER_ID, 2);
+  CHECK(!receiver.check_timeout(2 + FRAME_BYTE_TIMEOUT_MS), "partial frame dropped early");
+  CHECK(receiver.check_timeout(3 + FRAME_BYTE_TIMEOUT_MS) && !receiver.in_frame(), "partial frame kept");
+}
+
+void test_addressing() {
+  CHECK(request_address(HEATER_ID) == CONTROLLER_ID, "default heater request address 0x%02X",
+        request_address(HEATER_ID));
+  CHECK(request_address(HEATER_ID + 1) == CONTROLLER_ID + 1, "next heater request address 0x%02X",
+        request_address(HEATER_ID + 1));
+  // Echoes are told apart by length, whatever address they carry
+  std::vector<uint8_t> request = make_frame(request_address(HEATER_ID + 1), CONTROLLER_FRAME_LENGTH, 0x00);
+  CHECK(is_controller_frame(request), "addressed request not seen as a controller frame");
+  CHECK(!is_controller_frame(make_frame(HEATER_ID, HEATER_FRAME_LENGTH, 0x11)), "status frame seen as a request");
+}
+
+}  // namespace
+
+int main() {
+  test_validate_frame();
+  test_receiver();
+  test_addressing();
+  if (failures > 0) {
+    std::printf("%d checks failed\n", failures);
+    return 1;
+  }
+  std::printf("frame_receiver: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,96 @@
+// libFuzzer entry point for FrameReceiver::feed and validate_frame. The input is the
+// raw UART byte stream; every frame the receiver completes must be one validate_frame
+// accepts or rejects only for its checksum, the buffer must never outgrow a heater
+// frame, and a valid status frame sent after the input must be delivered unless a
+// candidate from the input took its bytes with a matching checksum (the collision
+// frame_property_test measures, together with the throughput floor). Built with -fsanitize=fuzzer under Clang (frame_fuzzer target); without
+// FRAME_FUZZ_LIBFUZZER a small main replays the files given on the command line, which
+// is how ctest runs the corpus in tests/corpus.
+#include "frame_receiver.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+using namespace esphome::vevor_heater;
+
+namespace {
+
+void require(bool condition, const char *what) {
+  if (!condition) {
+    std::fprintf(stderr, "invariant failed: %s\n", what);
+    std::abort();
+  }
+}
+
+// Off report as a Vevor heater sends it, the frame appended to every input
+std::vector<uint8_t> status_frame() {
+  std::vector<uint8_t> frame(HEATER_FRAME_SIZE, 0x00);
+  frame[0] = FRAME_START;
+  frame[1] = HEATER_ID;
+  frame[2] = 0x02;
+  frame[3] = HEATER_FRAME_LENGTH;
+  frame[6] = 0x01;
+  frame[11] = 0x7E;
+  frame.back() = calculate_checksum(frame);
+  return frame;
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size) {
+  // The whole input as one candidate frame
+  std::vector<uint8_t> raw(data, data + size);
+  FrameError raw_error = validate_frame(raw);
+  require(raw_error != FrameError::NONE || (size >= 4 && size == static_cast<size_t>(raw[3]) + 5),
+          "validate_frame accepted a frame whose size disagrees with its length byte");
+
+  // The input as a byte stream, 0x00 bytes after a 0xFF stand for a gap that times out
+  FrameReceiver receiver;
+  uint32_t now = 0;
+  bool gap = false;
+  static const std::vector<uint8_t> STATUS = status_frame();
+  std::vector<uint8_t> stream(data, data + size);
+  stream.insert(stream.end(), STATUS.begin(), STATUS.end());
+  bool recovered = false;
+  bool collided = false;
+  for (size_t i = 0; i < stream.size(); i++) {
+    now += (gap && stream[i] == 0x00 && i < size) ? FRAME_BYTE_TIMEOUT_MS + 1 : 2;
+    gap = stream[i] == 0xFF;
+    receiver.check_timeout(now);
+    if (receiver.feed(stream[i], now)) {
+      const std::vector<uint8_t> &frame = receiver.frame();
+      require(frame.size() == HEATER_FRAME_SIZE || frame.size() == CONTROLLER_FRAME_SIZE, "unexpected frame size");
+      FrameError error = validate_frame(frame);
+      require(error == FrameError::NONE || error == FrameError::CHECKSUM, "completed frame failed framing checks");
+      if (i + 1 == stream.size() && frame == STATUS) {
+        recovered = true;
+      } else if (i >= size && error == FrameError::NONE) {
+        collided = true;
+      }
+      receiver.reset();
+    }
+    require(receiver.frame().size() <= HEATER_FRAME_SIZE, "receiver buffer outgrew a heater frame");
+  }
+  require(recovered || collided, "status frame after the input was lost without a checksum collision");
+  return 0;
+}
+
+#ifndef FRAME_FUZZ_LIBFUZZER
+int main(int argc, char **argv) {
+  for (int i = 1; i < argc; i++) {
+    std::ifstream file(argv[i], std::ios::binary);
+    if (!file) {
+      std::fprintf(stderr, "cannot read %s\n", argv[i]);
+      return 1;
+    }
+    std::vector<uint8_t> input((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    LLVMFuzzerTestOneInput(input.data(), input.size());
+  }
+  std::printf("frame_fuzz: replayed %d inputs\n", argc - 1);
+  return 0;
+}
+#endif
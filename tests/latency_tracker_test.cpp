@@ -0,0 +1,230 @@
+// LatencyTracker fed with simulated send, response and confirmation timestamps: the
+// histogram and phase rules, then four heaters on one bus driven by the real
+// BusScheduler with start/stop commands at random times, checked against latency
+// budgets the way tools/bus_simulator.py --budget checks its model.
+#include "bus_scheduler.h"
+#include "frame_receiver.h"
+#include "latency_tracker.h"
+#include <algorithm>
+#include <cstdio>
+#include <random>
+
+using namespace esphome::vevor_heater;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if (!(cond)) { \
+      failures++; \
+      std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+      std::printf(__VA_ARGS__); \
+      std::printf("\n"); \
+    } \
+  } while (0)
+
+void test_histogram() {
+  LatencyHistogram histogram;
+  CHECK(histogram.get(LatencyStat::P95) == 0 && histogram.count() == 0, "empty histogram");
+
+  // Percentiles are bucket upper edges, capped at the largest sample
+  for (uint32_t ms = 1; ms <= 100; ms++) {
+    histogram.add(ms < 95 ? 40 : 180);
+  }
+  CHECK(histogram.get(LatencyStat::P50) == 50, "p50 %u", (unsigned) histogram.get(LatencyStat::P50));
+  CHECK(histogram.get(LatencyStat::P95) == 180, "p95 %u, capped at the max", (unsigned) histogram.get(LatencyStat::P95));
+  CHECK(histogram.get(LatencyStat::MAX) == 180, "max %u", (unsigned) histogram.get(LatencyStat::MAX));
+
+  // Above the last edge only the max is known
+  LatencyHistogram slow;
+  slow.add(45000);
+  CHECK(slow.percentile(50) == 45000, "overflow bucket p50 %u", (unsigned) slow.percentile(50));
+}
+
+void test_phases() {
+  LatencyTracker tracker;
+  const LatencyHistogram &round_trip = tracker.histogram(LatencyMetric::ROUND_TRIP);
+  const LatencyHistogram &wire = tracker.histogram(LatencyMetric::INTENT_TO_WIRE);
+  const LatencyHistogram &confirmed = tracker.histogram(LatencyMetric::INTENT_TO_CONFIRMED);
+
+  // Unsolicited frame, then a request and its reply
+  tracker.mark_response(100);
+  CHECK(round_trip.count() == 0, "unsolicited frame timed");
+  tracker.mark_sent(1000);
+  tracker.mark_sent(1000);  // The UART task reports the same send again
+  tracker.mark_response(1200);
+  tracker.mark_response(1250);  // Second frame for the same request
+  CHECK(round_trip.count() == 1 && round_trip.max() == 200, "round trip %u samples, max %u",
+        (unsigned) round_trip.count(), (unsigned) round_trip.max());
+
+  // A report before the command reached the wire does not confirm it
+  tracker.mark_intent(2000);
+  tracker.mark_confirmed(2100);
+  CHECK(confirmed.count() == 0 && tracker.intent_pending(), "confirmed before it was sent");
+  tracker.mark_sent(2200);  // Built before the intent, does not carry it
+  CHECK(wire.count() == 0, "frame built before the intent counted");
+  tracker.mark_built(2500);
+  tracker.mark_sent(2600);
+  tracker.mark_response(2800);
+  tracker.mark_confirmed(2800);
+  CHECK(wire.count() == 1 && wire.max() == 600, "intent to wire %u ms", (unsigned) wire.max());
+  CHECK(confirmed.count() == 1 && confirmed.max() == 800 && !tracker.intent_pending(), "intent to confirmed %u ms",
+        (unsigned) confirmed.max());
+
+  // Never confirmed
+  tracker.mark_intent(10000);
+  tracker.check_timeout(10000 + LATENCY_CONFIRM_TIMEOUT_MS - 1);
+  CHECK(tracker.intent_pending(), "intent dropped early");
+  tracker.check_timeout(10000 + LATENCY_CONFIRM_TIMEOUT_MS);
+  CHECK(!tracker.intent_pending() && tracker.unconfirmed() == 1, "unconfirmed intent not counted");
+}
+
+struct Budget {
+  LatencyMetric metric;
+  LatencyStat stat;
+  uint32_t limit_ms;
+};
+
+// Same budgets as the bus_simulator.py example, plus the confirmation a slot later
+const Budget BUDGETS[] = {
+    {LatencyMetric::ROUND_TRIP, LatencyStat::P95, 300},
+    {LatencyMetric::INTENT_TO_WIRE, LatencyStat::P95, 1500},
+    {LatencyMetric::INTENT_TO_CONFIRMED, LatencyStat::P95, 2000},
+};
+
+const char *stat_to_string(LatencyStat stat) {
+  switch (stat) {
+    case LatencyStat::P50: return "p50";
+    case LatencyStat::P95: return "p95";
+    default: return "max";
+  }
+}
+
+struct SimulatedHeater {
+  LatencyTracker tracker;
+  BusDeviceState base;
+  std::vector<uint32_t> intents;
+  size_t next_intent{0};
+};
+
+// 4800 baud 8N1: ten bits per byte
+uint32_t wire_ms(uint32_t bytes) { return (bytes * 10 * 1000 + 4799) / 4800; }
+
+// Runs the bus for duration_ms and returns the number of budgets exceeded
+int simulate_bus(uint32_t turnaround_ms, double loss, bool report) {
+  static const uint32_t DURATION_MS = 600000;
+  static const uint32_t INTENTS = 20;
+  static const uint32_t JITTER_MS = 40;
+  std::mt19937 rng(7);
+
+  BusScheduler scheduler;
+  std::vector<SimulatedHeater> heaters(4);
+  for (size_t i = 0; i < heaters.size(); i++) {
+    scheduler.add_device(static_cast<uint8_t>(HEATER_ID + i));
+    // Two running, two off and polled at the default 60 s
+    heaters[i].base = i < 2 ? BusDeviceState{BusPriority::ACTIVE, 1000} : BusDeviceState{BusPriority::IDLE, 60000};
+    for (uint32_t n = 0; n < INTENTS; n++) {
+      heaters[i].intents.push_back(rng() % DURATION_MS);
+    }
+    std::sort(heaters[i].intents.begin(), heaters[i].intents.end());
+  }
+  // Long enough for the slow heater below, so its replies are timed instead of lost
+  scheduler.set_slot_timeout(500);
+  scheduler.start(0);
+
+  uint32_t reply_at = 0;
+  bool reply_lost = false;
+  std::vector<BusDeviceState> states(heaters.size());
+  for (uint32_t now = 0; now < DURATION_MS; now++) {
+    for (SimulatedHeater &heater : heaters) {
+      // A command waits for the previous one, like a user waiting for the heater to react
+      if (heater.next_intent < heater.intents.size() && heater.intents[heater.next_intent] <= now &&
+          !heater.tracker.intent_pending()) {
+        heater.tracker.mark_intent(now);
+        heater.next_intent++;
+      }
+      heater.tracker.check_timeout(now);
+    }
+
+    if (scheduler.slot_open() && now == reply_at && !reply_lost) {
+      int index = scheduler.slot_device();
+      bool late;
+      scheduler.handle_reply(scheduler.device_id(index), now, &late);
+      // The heater reports the new state in the first reply after the command
+      heaters[index].tracker.mark_response(now);
+      heaters[index].tracker.mark_confirmed(now);
+    }
+    scheduler.check_timeout(now);
+
+    if (scheduler.can_open_slot(now, false)) {
+      for (size_t i = 0; i < heaters.size(); i++) {
+        // A pending command polls fast, as get_bus_priority() does for a starting or stopping heater
+        states[i] = heaters[i].tracker.intent_pending() ? BusDeviceState{BusPriority::TRANSITIONAL, 1000}
+                                                        : heaters[i].base;
+      }
+      int next = scheduler.select_next_device(now, states);
+      if (next != BusScheduler::NO_SLOT) {
+        heaters[next].tracker.mark_built(now);
+        heaters[next].tracker.mark_sent(now);
+        scheduler.open_slot(next, now);
+        // Measured from the start of the request, like the component
+        reply_at = now + wire_ms(CONTROLLER_FRAME_SIZE) + turnaround_ms + rng() % (JITTER_MS + 1) +
+                   wire_ms(HEATER_FRAME_SIZE);
+        reply_lost = std::uniform_real_distribution<double>(0.0, 1.0)(rng) < loss;
+      }
+    }
+  }
+
+  if (report) {
+    heaters[0].tracker.dump_config("latency");
+  }
+  int exceeded = 0;
+  for (const Budget &budget : BUDGETS) {
+    // Worst heater, a budget holds for every one of them
+    uint32_t worst = 0;
+    uint32_t samples = 0;
+    for (const SimulatedHeater &heater : heaters) {
+      const LatencyHistogram &histogram = heater.tracker.histogram(budget.metric);
+      samples += histogram.count();
+      if (histogram.get(budget.stat) > worst) {
+        worst = histogram.get(budget.stat);
+      }
+    }
+    bool ok = samples > 0 && worst <= budget.limit_ms;
+    if (!ok) {
+      exceeded++;
+    }
+    if (report) {
+      std::printf("latency budget %s %s: %u ms of %u ms over %u samples%s\n",
+                  LatencyTracker::metric_to_string(budget.metric), stat_to_string(budget.stat),
+                  (unsigned) worst, (unsigned) budget.limit_ms, (unsigned) samples, ok ? "" : " EXCEEDED");
+    }
+  }
+  return exceeded;
+}
+
+void test_bus_budgets() {
+  // 30 ms heater turnaround, 2% of requests unanswered
+  int exceeded = simulate_bus(30, 0.02, true);
+  CHECK(exceeded == 0, "%d latency budgets exceeded", exceeded);
+
+  // A heater answering 200 ms late must break the round trip budget, or the check is blind
+  exceeded = simulate_bus(200, 0.0, false);
+  CHECK(exceeded > 0, "slow heater passed every latency budget");
+}
+
+}  // namespace
+
+int main() {
+  test_histogram();
+  test_phases();
+  test_bus_budgets();
+  if (failures > 0) {
+    std::printf("%d checks failed\n", failures);
+    return 1;
+  }
+  std::printf("latency_tracker: all checks passed\n");
+  return 0;
+}
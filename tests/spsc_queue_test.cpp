@@ -0,0 +1,173 @@
+// SpscQueue and Seqlock across two std::threads, standing in for the UART task and the
+// main loop: ordered, lossless queue handoff and no torn seqlock reads.
+#include "spsc_queue.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using namespace esphome::vevor_heater;
+
+namespace {
+
+int failures = 0;
+
+#define CHECK(cond, ...) \
+  do { \
+    if (!(cond)) { \
+      failures++; \
+      std::printf("FAIL %s:%d: ", __FILE__, __LINE__); \
+      std::printf(__VA_ARGS__); \
+      std::printf("\n"); \
+    } \
+  } while (0)
+
+// Received frame sized item, every byte derived from the sequence number
+struct Item {
+  uint32_t sequence;
+  uint8_t data[56];
+};
+
+Item make_item(uint32_t sequence) {
+  Item item;
+  item.sequence = sequence;
+  for (size_t i = 0; i < sizeof(item.data); i++) {
+    item.data[i] = static_cast<uint8_t>(sequence * 31 + i);
+  }
+  return item;
+}
+
+bool item_intact(const Item &item) {
+  for (size_t i = 0; i < sizeof(item.data); i++) {
+    if (item.data[i] != static_cast<uint8_t>(item.sequence * 31 + i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void test_queue_single_thread() {
+  SpscQueue<Item, 4> queue;
+  Item item;
+  CHECK(queue.empty() && !queue.pop(&item), "new queue not empty");
+  for (uint32_t i = 0; i < 4; i++) {
+    CHECK(queue.push(make_item(i)), "push %u into a queue with room", (unsigned) i);
+  }
+  CHECK(!queue.push(make_item(4)) && queue.size() == 4, "push into a full queue");
+  for (uint32_t i = 0; i < 4; i++) {
+    CHECK(queue.pop(&item) && item.sequence == i, "pop %u", (unsigned) i);
+  }
+  CHECK(queue.empty(), "queue not empty after draining");
+}
+
+void test_queue_threads() {
+  static const uint32_t COUNT = 200000;
+  SpscQueue<Item, 8> queue;
+  uint32_t full = 0;
+
+  std::thread producer([&]() {
+    for (uint32_t i = 0; i < COUNT; i++) {
+      while (!queue.push(make_item(i))) {
+        full++;
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  uint32_t expected = 0;
+  uint32_t out_of_order = 0;
+  uint32_t corrupted = 0;
+  Item item;
+  while (expected < COUNT) {
+    if (!queue.pop(&item)) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (item.sequence != expected) {
+      out_of_order++;
+      expected = item.sequence;
+    }
+    if (!item_intact(item)) {
+      corrupted++;
+    }
+    expected++;
+  }
+  producer.join();
+
+  CHECK(out_of_order == 0, "%u items out of order or lost", (unsigned) out_of_order);
+  CHECK(corrupted == 0, "%u items corrupted", (unsigned) corrupted);
+  CHECK(queue.empty(), "items left after the last one");
+  std::printf("spsc queue: %u items, producer found the queue full %u times\n", (unsigned) COUNT, (unsigned) full);
+}
+
+// Transmit request sized value whose words must always agree
+struct Request {
+  uint32_t words[5];
+};
+
+void test_seqlock_threads() {
+  static const uint32_t WRITES = 100000;
+  Seqlock<Request> cell;
+  Request value;
+  CHECK(!cell.read(&value), "read before the first write");
+
+  std::atomic<bool> done{false};
+  std::thread writer([&]() {
+    for (uint32_t i = 1; i <= WRITES; i++) {
+      Request request;
+      for (uint32_t &word : request.words) {
+        word = i;
+      }
+      cell.write(request);
+      // Gaps like the main loop's, a writer that never pauses starves every reader
+      if (i % 16 == 0) {
+        std::this_thread::sleep_for(std::chrono::microseconds(1));
+      }
+    }
+    done.store(true);
+  });
+
+  uint32_t reads = 0;
+  uint32_t retries = 0;
+  uint32_t torn = 0;
+  uint32_t backwards = 0;
+  uint32_t last = 0;
+  while (!done.load()) {
+    if (!cell.read(&value)) {
+      retries++;
+      continue;
+    }
+    reads++;
+    for (uint32_t word : value.words) {
+      if (word != value.words[0]) {
+        torn++;
+        break;
+      }
+    }
+    if (value.words[0] < last) {
+      backwards++;
+    }
+    last = value.words[0];
+  }
+  writer.join();
+
+  CHECK(reads > 0, "no read succeeded while the writer ran");
+  CHECK(torn == 0, "%u torn reads", (unsigned) torn);
+  CHECK(backwards == 0, "%u reads went back in time", (unsigned) backwards);
+  CHECK(cell.read(&value) && value.words[0] == WRITES, "last write not read");
+  std::printf("seqlock: %u reads, %u overlapped a write and were retried\n", (unsigned) reads, (unsigned) retries);
+}
+
+}  // namespace
+
+int main() {
+  test_queue_single_thread();
+  test_queue_threads();
+  test_seqlock_threads();
+  if (failures > 0) {
+    std::printf("%d checks failed\n", failures);
+    return 1;
+  }
+  std::printf("spsc_queue: all checks passed\n");
+  return 0;
+}
@@ -0,0 +1,4 @@
+#pragma once
+
+// Host builds have no ESPHome codegen, the model comes from the VEVOR_HEATER_MODEL
+// CMake option instead (see tests/CMakeLists.txt)
@@ -0,0 +1,7 @@
+#pragma once
+
+// Host builds print config dumps to stdout, enough for the ESPHome-free parts of the
+// component that only log from dump_config()
+#include <cstdio>
+
+#define ESP_LOGCONFIG(tag, ...) (std::printf("[C][%s] ", tag), std::printf(__VA_ARGS__), std::printf("\n"))
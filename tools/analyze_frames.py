@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Rank candidate fields in Vevor heater status frames from a capture.
+
+Feed it ESPHome logs containing "CAPTURE AA 77 ..." lines (from the frame capture
+dump button), or any text with one 56-byte hex frame per line:
+
+    python3 tools/analyze_frames.py heater.log [more.log ...]
+
+For every byte offset (and adjacent big-endian byte pair) the tool prints entropy
+and the correlation with the fields that are already decoded, then ranks the
+offsets nobody decodes yet by how informative they look.
+"""
+
+import argparse
+import math
+import re
+import sys
+
+FRAME_SIZE = 56
+
+# Offsets decoded by update_sensors(), name -> (offset, length, scale)
+KNOWN_FIELDS = {
+    "state": (5, 1, 1.0),
+    "power": (6, 1, 1.0),
+    "voltage": (11, 1, 0.1),
+    "glow_current": (13, 1, 1.0),
+    "cooling": (14, 1, 1.0),
+    "heat_exchanger": (16, 2, 0.1),
+    "state_duration": (20, 2, 1.0),
+    "pump": (23, 1, 0.1),
+    "fan": (28, 2, 1.0),
+}
+KNOWN_OFFSETS = {
+    offset + i for offset, length, _ in KNOWN_FIELDS.values() for i in range(length)
+}
+# Start byte, device id, length and checksum
+FRAMING_OFFSETS = {0, 1, 3, FRAME_SIZE - 1}
+
+HEX_FRAME = re.compile(r"((?:[0-9A-Fa-f]{2}[ .:]?){%d})" % FRAME_SIZE)
+
+
+def parse_frames(lines):
+    """Extract distinct status frames, keeping first-seen order."""
+    seen = set()
+    frames = []
+    for line in lines:
+        match = HEX_FRAME.search(line)
+        if not match:
+            continue
+        data = bytes.fromhex(re.sub(r"[ .:]", "", match.group(1)))
+        if data[0] != 0xAA or data in seen:
+            continue
+        seen.add(data)
+        frames.append(data)
+    return frames
+
+
+def field_value(frame, offset, length, scale):
+    value = 0
+    for i in range(length):
+        value = (value << 8) | frame[offset + i]
+    if length == 2 and value & 0x8000:
+        value -= 0x10000
+    return value * scale
+
+
+def entropy(values):
+    counts = {}
+    for value in values:
+        counts[value] = counts.get(value, 0) + 1
+    total = len(values)
+    return -sum(c / total * math.log2(c / total) for c in counts.values())
+
+
+def correlation(xs, ys):
+    n = len(xs)
+    mean_x = sum(xs) / n
+    mean_y = sum(ys) / n
+    cov = sum((x - mean_x) * (y - mean_y) for x, y in zip(xs, ys))
+    var_x = sum((x - mean_x) ** 2 for x in xs)
+    var_y = sum((y - mean_y) ** 2 for y in ys)
+    if var_x == 0 or var_y == 0:
+        return float("nan")
+    return cov / math.sqrt(var_x * var_y)
+
+
+def analyze(frames, min_entropy):
+    known = {
+        name: [field_value(f, *spec) for f in frames]
+        for name, spec in KNOWN_FIELDS.items()
+    }
+
+    candidates = []
+    for length in (1, 2):
+        for offset in range(FRAME_SIZE - length + 1):
+            covered = set(range(offset, offset + length))
+            if covered & (KNOWN_OFFSETS | FRAMING_OFFSETS):
+                continue
+            values = [field_value(f, offset, length, 1.0) for f in frames]
+            bits = entropy(values)
+            if bits < min_entropy:
+                continue
+            correlations = {name: correlation(values, ys) for name, ys in known.items()}
+            best_name, best_r = max(
+                ((n, r) for n, r in correlations.items() if not math.isnan(r)),
+                key=lambda item: abs(item[1]),
+                default=(None, 0.0),
+            )
+            # Informative bytes vary a lot and track something physical
+            score = bits * (0.5 + abs(best_r))
+            candidates.append((score, offset, length, bits, best_name, best_r, min(values), max(values)))
+
+    candidates.sort(reverse=True)
+    return candidates
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="*", help="Log files (default: stdin)")
+    parser.add_argument("--min-entropy", type=float, default=0.5, help="Skip offsets below this many bits")
+    parser.add_argument("--top", type=int, default=20, help="Number of candidates to print")
+    args = parser.parse_args()
+
+    lines = []
+    if args.files:
+        for path in args.files:
+            with open(path, encoding="utf-8", errors="replace") as handle:
+                lines.extend(handle)
+    else:
+        lines = sys.stdin.readlines()
+
+    frames = parse_frames(lines)
+    if len(frames) < 2:
+        print(f"Need at least 2 distinct frames, found {len(frames)}")
+        return 1
+
+    print(f"{len(frames)} distinct status frames\n")
+    print(f"{'offset':>8} {'len':>3} {'entropy':>8} {'min':>6} {'max':>6}  best correlation")
+    for score, offset, length, bits, name, r, low, high in analyze(frames, args.min_entropy)[: args.top]:
+        label = f"{offset}" if length == 1 else f"{offset}-{offset + 1}"
+        match = f"{name} r={r:+.2f}" if name else "-"
+        print(f"{label:>8} {length:>3} {bits:>8.2f} {low:>6.0f} {high:>6.0f}  {match}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
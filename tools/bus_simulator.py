@@ -0,0 +1,326 @@
+#!/usr/bin/env python3
+"""Simulate several Vevor heaters sharing one UART through the vevor_heater bus manager.
+
+Models the slot scheduler of VevorBus (bus_scheduler.cpp): one request per slot,
+a guard time between slots, replies matched by device ID, timeouts for missing
+replies, transitional devices served before active and idle ones, and aging so
+a saturated bus slows idle devices down instead of starving them. Use it to
+check how many heaters a bus could carry before polling falls behind. It is a
+model of the scheduler only: it assumes every heater answers its addressed
+request, which is not confirmed on hardware, so the component only lets heaters
+share a UART when all of them opt in with addressed_requests. The host tests in
+tests/ drive the real scheduler.
+
+    python3 tools/bus_simulator.py --devices 4 --transitional 1 --active 2
+    python3 tools/bus_simulator.py --sweep 8 --loss 0.02
+
+Reported per priority class: achieved poll interval against the requested one
+and the worst-case delay between a device becoming due and its request.
+
+With --intents, every device gets that many start/stop commands at random times
+and the same latency histograms as the component (latency_tracker.h) are
+reported: request round trip, intent to wire and intent to confirmed state.
+--budget fails the run (exit code 1) when a percentile exceeds its limit, so
+scheduler changes can be checked in CI:
+
+    python3 tools/bus_simulator.py --devices 4 --intents 20 \
+        --budget round_trip:p95=300 --budget intent_to_wire:p95=1500
+"""
+
+import argparse
+import random
+import sys
+
+BAUD_RATE = 4800
+BITS_PER_BYTE = 10  # 8N1
+CONTROLLER_FRAME_BYTES = 16
+HEATER_FRAME_BYTES = 56
+
+# Same constants as the component
+SEND_INTERVAL_MS = 1000
+BUS_GUARD_TIME_MS = 20
+
+# Same bucket edges as LATENCY_BUCKET_EDGES_MS in latency_tracker.h
+LATENCY_BUCKET_EDGES_MS = [10, 20, 50, 100, 150, 200, 300, 500, 750, 1000, 1500, 2000, 3000, 5000, 10000, 30000]
+LATENCY_METRICS = ["round_trip", "intent_to_wire", "intent_to_confirmed"]
+LATENCY_STATS = ["p50", "p95", "max"]
+
+TRANSITIONAL, ACTIVE, IDLE = 2, 1, 0
+CLASS_NAMES = {TRANSITIONAL: "transitional", ACTIVE: "active", IDLE: "idle"}
+
+
+class LatencyHistogram:
+    """Fixed-bucket histogram, percentiles computed exactly like the component."""
+
+    def __init__(self):
+        self.counts = [0] * (len(LATENCY_BUCKET_EDGES_MS) + 1)
+        self.count = 0
+        self.max = 0
+
+    def add(self, ms):
+        bucket = 0
+        while bucket < len(LATENCY_BUCKET_EDGES_MS) and ms > LATENCY_BUCKET_EDGES_MS[bucket]:
+            bucket += 1
+        self.counts[bucket] += 1
+        self.count += 1
+        self.max = max(self.max, ms)
+
+    def merge(self, other):
+        self.counts = [a + b for a, b in zip(self.counts, other.counts)]
+        self.count += other.count
+        self.max = max(self.max, other.max)
+
+    def percentile(self, percent):
+        # Upper edge of the bucket holding the sample, capped at the largest sample
+        if self.count == 0:
+            return 0
+        rank = -(-self.count * percent // 100)
+        seen = 0
+        for bucket, edge in enumerate(LATENCY_BUCKET_EDGES_MS):
+            seen += self.counts[bucket]
+            if seen >= rank:
+                return min(edge, self.max)
+        return self.max
+
+    def get(self, stat):
+        return self.max if stat == "max" else self.percentile(int(stat[1:]))
+
+
+def wire_time_ms(frame_bytes):
+    # Whole milliseconds like millis() on the device, rounded up
+    return -(-frame_bytes * BITS_PER_BYTE * 1000 // BAUD_RATE)
+
+
+class Device:
+    def __init__(self, device_id, priority, polling_interval_ms):
+        self.device_id = device_id
+        self.priority = priority
+        self.interval = SEND_INTERVAL_MS if priority != IDLE else polling_interval_ms
+        self.last_poll = None
+        self.polls = 0
+        self.responses = 0
+        self.timeouts = 0
+        self.late = 0
+        self.max_delay = 0
+        self.histograms = {metric: LatencyHistogram() for metric in LATENCY_METRICS}
+        self.intents = []          # Pending command times, ascending
+        self.intent = None         # Command in flight
+        self.wired = False
+        self.replies_needed = 0
+        self.base = (priority, self.interval)
+
+    def start_intent(self, now):
+        # A start or stop makes the component poll every second until it is confirmed
+        self.intent = self.intents.pop(0)
+        self.wired = False
+        self.priority, self.interval = TRANSITIONAL, SEND_INTERVAL_MS
+
+    def overdue(self, now):
+        if self.last_poll is None:
+            return float("inf")
+        return now - self.last_poll - self.interval
+
+
+def effective_priority(device, now):
+    # Aging: waiting a whole extra interval promotes a device to the top class
+    return TRANSITIONAL if device.overdue(now) >= device.interval else device.priority
+
+
+def select_next(devices, now):
+    """Highest priority class first, then the device furthest past its interval."""
+    best = None
+    best_key = None
+    for device in devices:
+        overdue = device.overdue(now)
+        if overdue < 0:
+            continue
+        key = (effective_priority(device, now), overdue)
+        if best is None or key > best_key:
+            best, best_key = device, key
+    return best
+
+
+def simulate(devices, duration_ms, slot_timeout_ms, turnaround_ms, jitter_ms, loss, rng, confirm_replies=1):
+    request_ms = wire_time_ms(CONTROLLER_FRAME_BYTES)
+    reply_ms = wire_time_ms(HEATER_FRAME_BYTES)
+    now = 0
+    busy = 0
+    slots = 0
+
+    while now < duration_ms:
+        for d in devices:
+            if d.intent is None and d.intents and d.intents[0] <= now:
+                d.start_intent(now)
+
+        device = select_next(devices, now)
+        if device is None:
+            # Idle line until the next device becomes due or gets a command
+            now = min(d.last_poll + d.interval for d in devices)
+            now = min([now] + [d.intents[0] for d in devices if d.intent is None and d.intents])
+            continue
+
+        if device.last_poll is not None:
+            device.max_delay = max(device.max_delay, device.overdue(now))
+        device.last_poll = now
+        device.polls += 1
+        slots += 1
+        if device.intent is not None and not device.wired:
+            device.histograms["intent_to_wire"].add(now - device.intent)
+            device.wired = True
+            device.replies_needed = confirm_replies
+
+        # Reply timing is measured from the start of the request, like the component does
+        latency = request_ms + turnaround_ms + rng.randint(0, jitter_ms) + reply_ms
+        if rng.random() < loss:
+            device.timeouts += 1
+            slot_ms = slot_timeout_ms
+        elif latency > slot_timeout_ms:
+            # Slot closed first; the reply still arrives and is delivered as late
+            device.timeouts += 1
+            device.late += 1
+            slot_ms = latency
+        else:
+            device.responses += 1
+            device.histograms["round_trip"].add(latency)
+            slot_ms = latency
+            if device.wired:
+                # The heater reports the new state in the n-th reply after the command
+                device.replies_needed -= 1
+                if device.replies_needed == 0:
+                    device.histograms["intent_to_confirmed"].add(now + latency - device.intent)
+                    device.intent = None
+                    device.wired = False
+                    device.priority, device.interval = device.base
+
+        busy += slot_ms
+        now += slot_ms + BUS_GUARD_TIME_MS
+
+    return slots, busy / max(now, 1)
+
+
+def make_devices(count, transitional, active, polling_interval_ms):
+    devices = []
+    for i in range(count):
+        if i < transitional:
+            priority = TRANSITIONAL
+        elif i < transitional + active:
+            priority = ACTIVE
+        else:
+            priority = IDLE
+        devices.append(Device(0x77 + i, priority, polling_interval_ms))
+    return devices
+
+
+def schedule_intents(devices, count, duration_ms, rng):
+    for device in devices:
+        device.intents = sorted(rng.randrange(duration_ms) for _ in range(count))
+
+
+def merged_histograms(devices):
+    merged = {metric: LatencyHistogram() for metric in LATENCY_METRICS}
+    for device in devices:
+        for metric in LATENCY_METRICS:
+            merged[metric].merge(device.histograms[metric])
+    return merged
+
+
+def report_latency(histograms):
+    print(f"{'latency':>20} {'samples':>8} {'p50':>8} {'p95':>8} {'max':>8}")
+    for metric in LATENCY_METRICS:
+        h = histograms[metric]
+        if h.count == 0:
+            continue
+        print(f"{metric:>20} {h.count:>8} {h.get('p50'):>6}ms {h.get('p95'):>6}ms {h.get('max'):>6}ms")
+
+
+def parse_budget(value):
+    """metric:stat=ms, e.g. round_trip:p95=300"""
+    try:
+        key, limit = value.split("=")
+        metric, stat = key.split(":")
+        limit = int(limit)
+    except ValueError as err:
+        raise argparse.ArgumentTypeError(f"budget must look like round_trip:p95=300, got '{value}'") from err
+    if metric not in LATENCY_METRICS or stat not in LATENCY_STATS:
+        raise argparse.ArgumentTypeError(
+            f"budget metric must be one of {', '.join(LATENCY_METRICS)} and stat one of {', '.join(LATENCY_STATS)}"
+        )
+    return metric, stat, limit
+
+
+def check_budgets(histograms, budgets):
+    """Returns the number of exceeded budgets, printing each one."""
+    failed = 0
+    for metric, stat, limit in budgets:
+        value = histograms[metric].get(stat)
+        if histograms[metric].count == 0:
+            print(f"budget {metric}:{stat}: no samples")
+            failed += 1
+        elif value > limit:
+            print(f"budget {metric}:{stat} exceeded: {value}ms > {limit}ms")
+            failed += 1
+    return failed
+
+
+def report(devices, slots, utilisation, duration_ms):
+    print(f"{len(devices)} devices, {slots / (duration_ms / 1000.0):.2f} slots/s, line busy {utilisation * 100:.0f}%")
+    print(f"{'class':>13} {'devices':>7} {'interval':>9} {'achieved':>9} {'worst delay':>12} {'latency max':>12} {'timeouts':>9}")
+    for priority in (TRANSITIONAL, ACTIVE, IDLE):
+        members = [d for d in devices if d.priority == priority]
+        if not members:
+            continue
+        polls = sum(d.polls for d in members)
+        achieved = duration_ms * len(members) / polls if polls else float("inf")
+        worst = max(d.max_delay for d in members)
+        latency = max(d.histograms["round_trip"].max for d in members)
+        timeouts = sum(d.timeouts for d in members)
+        print(
+            f"{CLASS_NAMES[priority]:>13} {len(members):>7} {members[0].interval:>7}ms {achieved:>7.0f}ms "
+            f"{worst:>10.0f}ms {latency:>10.0f}ms {timeouts:>9}"
+        )
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--devices", type=int, default=3, help="Heaters on the bus")
+    parser.add_argument("--transitional", type=int, default=1, help="Heaters starting or stopping")
+    parser.add_argument("--active", type=int, default=1, help="Heaters running steadily")
+    parser.add_argument("--polling-interval", type=int, default=60000, help="Idle polling interval in ms")
+    parser.add_argument("--slot-timeout", type=int, default=300, help="Slot timeout in ms")
+    parser.add_argument("--turnaround", type=int, default=30, help="Heater reply delay after a request in ms")
+    parser.add_argument("--jitter", type=int, default=40, help="Random extra reply delay in ms")
+    parser.add_argument("--loss", type=float, default=0.0, help="Fraction of requests without reply")
+    parser.add_argument("--duration", type=int, default=600, help="Simulated time in seconds")
+    parser.add_argument("--sweep", type=int, help="Report 1..N devices, half of them transitional")
+    parser.add_argument("--intents", type=int, default=0, help="Start/stop commands per device")
+    parser.add_argument("--confirm-replies", type=int, default=1, help="Replies until the heater reports a command")
+    parser.add_argument("--budget", type=parse_budget, action="append", default=[],
+                        help="Latency budget metric:stat=ms, fails the run when exceeded (repeatable)")
+    parser.add_argument("--seed", type=int, default=1)
+    args = parser.parse_args()
+
+    rng = random.Random(args.seed)
+    duration_ms = args.duration * 1000
+    counts = range(1, args.sweep + 1) if args.sweep else [args.devices]
+    failed = 0
+    for count in counts:
+        if args.sweep:
+            transitional, active = count - count // 2, 0
+        else:
+            transitional, active = min(args.transitional, count), min(args.active, count - args.transitional)
+        devices = make_devices(count, transitional, max(active, 0), args.polling_interval)
+        schedule_intents(devices, args.intents, duration_ms, rng)
+        slots, utilisation = simulate(
+            devices, duration_ms, args.slot_timeout, args.turnaround, args.jitter, args.loss, rng,
+            args.confirm_replies,
+        )
+        report(devices, slots, utilisation, duration_ms)
+        histograms = merged_histograms(devices)
+        report_latency(histograms)
+        failed += check_budgets(histograms, args.budget)
+        print()
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
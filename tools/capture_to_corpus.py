@@ -0,0 +1,60 @@
+#!/usr/bin/env python3
+"""Turn a frame capture into fuzz corpus files for the host tests.
+
+Feed it ESPHome logs containing "CAPTURE AA 77 ..." lines (from the frame capture
+dump button) and it writes every distinct status frame as one .bin file:
+
+    python3 tools/capture_to_corpus.py heater.log --out tests/corpus --prefix garage
+
+ctest replays tests/corpus/*.bin through the fuzz entry point, and frame_property_test
+embeds every valid frame it finds there in random noise, so captured frames from real
+heaters are checked next to the generated ones. Frames whose checksum fails are kept
+too, they exercise the receiver's rejection path.
+"""
+
+import argparse
+import os
+import sys
+
+from analyze_frames import parse_frames
+
+
+def checksum(frame):
+    """Sum of bytes 2 to the second to last, modulo 256, like calculate_checksum()."""
+    return sum(frame[2:-1]) % 256
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("files", nargs="*", help="Log files (default: stdin)")
+    parser.add_argument("--out", default="tests/corpus", help="Corpus directory")
+    parser.add_argument("--prefix", default="capture", help="File name prefix, e.g. the heater or site")
+    args = parser.parse_args()
+
+    lines = []
+    if args.files:
+        for path in args.files:
+            with open(path, encoding="utf-8", errors="replace") as handle:
+                lines.extend(handle)
+    else:
+        lines = sys.stdin.readlines()
+
+    frames = parse_frames(lines)
+    if not frames:
+        print("No CAPTURE frames found")
+        return 1
+
+    os.makedirs(args.out, exist_ok=True)
+    bad = 0
+    for index, frame in enumerate(frames):
+        if checksum(frame) != frame[-1]:
+            bad += 1
+        path = os.path.join(args.out, f"{args.prefix}_{index:03d}.bin")
+        with open(path, "wb") as handle:
+            handle.write(frame)
+    print(f"Wrote {len(frames)} frames to {args.out} ({bad} with a checksum mismatch)")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
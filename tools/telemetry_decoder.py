@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+"""Decode vevor_heater binary MQTT telemetry and estimate its data cost.
+
+Decode payloads from a subscriber, one hex payload per line or raw bytes:
+
+    mosquitto_sub -t 'camper/vevor_heater/+/telemetry' -F '%x' | python3 tools/telemetry_decoder.py decode
+    python3 tools/telemetry_decoder.py decode --raw payload.bin
+
+Compare bytes on air per hour with per-entity MQTT publishing:
+
+    python3 tools/telemetry_decoder.py benchmark --interval 60 --state-changes 6
+
+Payload schema version 1, 38 bytes, little-endian:
+
+    offset type  field                       scale / unknown value
+     0     u8    schema version              1
+     1     u8    flags                       bit0 connected, bit1 cooling down,
+                                             bit2 low fuel, bit3 locked out,
+                                             bit4 stale (restored at boot)
+     2     u8    heater state                0 off, 1 polling, 2 heating up,
+                                             3 stable combustion, 4 stopping/cooling
+     3     u8    controller state            0 idle, 1 starting, 2 running,
+                                             3 stopping, 4 lockout, 5 fault
+     4     u8    power level                 1-10 as reported by the heater
+     5     u8    failed starts
+     6     u16   state duration              s
+     8     u16   fan speed                   rpm
+    10     i16   input voltage               0.1 V, -32768 unknown
+    12     i16   heat exchanger temperature  0.1 C, -32768 unknown
+    14     i16   external temperature        0.1 C, -32768 unknown
+    16     u8    glow plug current           A, 255 unknown
+    17     u8    pump frequency              0.1 Hz, 255 unknown
+    18     u16   consumption rate            0.1 ml/h, 65535 unknown
+    20     u32   daily consumption           0.1 ml, 0xFFFFFFFF unknown
+    24     u32   total consumption           ml, 0xFFFFFFFF unknown
+    28     u16   tank level                  0.01 %, 65535 unknown (no tank)
+    30     u16   fault count
+    32     u8    last fault code             see FAULT_NAMES
+    33     u8    reserved
+    34     u32   sequence                    +1 per publish, gaps mean lost messages
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+SCHEMA_VERSION = 1
+PAYLOAD_FORMAT = "<BBBBBBHHhhhBBHIIHHBBI"
+PAYLOAD_SIZE = struct.calcsize(PAYLOAD_FORMAT)
+
+FIELDS = (
+    "schema", "flags", "heater_state", "controller_state", "power_level", "failed_starts",
+    "state_duration", "fan_speed", "input_voltage", "heat_exchanger_temperature",
+    "external_temperature", "glow_plug_current", "pump_frequency", "consumption_rate",
+    "daily_consumption", "total_consumption", "tank_level", "fault_count", "last_fault",
+    "reserved", "sequence",
+)
+
+HEATER_STATES = {0: "Off", 1: "Polling", 2: "Heating Up", 3: "Stable Combustion", 4: "Stopping/Cooling"}
+CONTROLLER_STATES = {0: "Idle", 1: "Starting", 2: "Running", 3: "Stopping", 4: "Lockout", 5: "Fault"}
+FAULT_NAMES = {
+    0: "None", 1: "Ignition Failure", 2: "Flame Out", 3: "Overheat", 4: "Pump Fault",
+    5: "Low Voltage", 6: "Communication Lost", 7: "Unknown State",
+}
+
+# name -> (scale, unknown raw value)
+SCALED = {
+    "input_voltage": (0.1, -32768),
+    "heat_exchanger_temperature": (0.1, -32768),
+    "external_temperature": (0.1, -32768),
+    "glow_plug_current": (1.0, 0xFF),
+    "pump_frequency": (0.1, 0xFF),
+    "consumption_rate": (0.1, 0xFFFF),
+    "daily_consumption": (0.1, 0xFFFFFFFF),
+    "total_consumption": (1.0, 0xFFFFFFFF),
+    "tank_level": (0.01, 0xFFFF),
+}
+
+assert PAYLOAD_SIZE == 38
+
+
+def decode(payload):
+    """Decode one payload into a dict, raising ValueError for a wrong size or schema."""
+    if len(payload) != PAYLOAD_SIZE:
+        raise ValueError(f"expected {PAYLOAD_SIZE} bytes, got {len(payload)}")
+    raw = dict(zip(FIELDS, struct.unpack(PAYLOAD_FORMAT, payload)))
+    if raw["schema"] != SCHEMA_VERSION:
+        raise ValueError(f"unsupported schema version {raw['schema']}")
+
+    result = {
+        "sequence": raw["sequence"],
+        "heater_state": HEATER_STATES.get(raw["heater_state"], f"Unknown (0x{raw['heater_state']:02X})"),
+        "controller_state": CONTROLLER_STATES.get(raw["controller_state"], "Unknown"),
+        "connected": bool(raw["flags"] & 0x01),
+        "cooling_down": bool(raw["flags"] & 0x02),
+        "low_fuel": bool(raw["flags"] & 0x04),
+        "locked_out": bool(raw["flags"] & 0x08),
+        "stale": bool(raw["flags"] & 0x10),
+        "power_level": raw["power_level"],
+        "failed_starts": raw["failed_starts"],
+        "state_duration": raw["state_duration"],
+        "fan_speed": raw["fan_speed"],
+        "fault_count": raw["fault_count"],
+        "last_fault": FAULT_NAMES.get(raw["last_fault"], "Unknown"),
+    }
+    for name, (scale, unknown) in SCALED.items():
+        result[name] = None if raw[name] == unknown else round(raw[name] * scale, 2)
+    return result
+
+
+def parse_hex_lines(lines):
+    for line in lines:
+        digits = re.sub(r"[^0-9A-Fa-f]", "", line)
+        if digits:
+            yield bytes.fromhex(digits)
+
+
+def command_decode(args):
+    if args.raw:
+        with open(args.raw, "rb") as handle:
+            payloads = [handle.read()]
+    else:
+        payloads = parse_hex_lines(sys.stdin)
+
+    last_sequence = None
+    for payload in payloads:
+        try:
+            fields = decode(payload)
+        except ValueError as err:
+            print(f"skipped: {err}", file=sys.stderr)
+            continue
+        if last_sequence is not None and fields["sequence"] != last_sequence + 1:
+            print(f"# {fields['sequence'] - last_sequence - 1} message(s) lost", file=sys.stderr)
+        last_sequence = fields["sequence"]
+        print(", ".join(f"{key}={value}" for key, value in fields.items()))
+    return 0
+
+
+# Entities published per status frame with the default auto sensors: (domain, object id, typical payload)
+PER_FRAME_ENTITIES = (
+    ("text_sensor", "vevor_heater_state", "Stable Combustion"),
+    ("sensor", "vevor_heater_power_level", "80"),
+    ("sensor", "vevor_heater_input_voltage", "12.6"),
+    ("sensor", "vevor_heater_glow_plug_current", "0"),
+    ("binary_sensor", "vevor_heater_cooling_down", "OFF"),
+    ("sensor", "vevor_heater_heat_exchanger_temperature", "142.5"),
+    ("sensor", "vevor_heater_state_duration", "1820"),
+    ("sensor", "vevor_heater_pump_frequency", "3.2"),
+    ("sensor", "vevor_heater_fan_speed", "4100"),
+    ("sensor", "vevor_heater_daily_consumption", "812.3"),
+    ("sensor", "vevor_heater_total_consumption", "48211"),
+    ("sensor", "vevor_heater_hourly_consumption", "253.4"),
+)
+
+
+def mqtt_publish_size(topic, payload_length):
+    """QoS 0 PUBLISH: fixed header, remaining length, topic length, topic, payload."""
+    remaining = 2 + len(topic) + payload_length
+    length_bytes = 1 if remaining < 128 else 2 if remaining < 16384 else 3
+    return 1 + length_bytes + remaining
+
+
+def command_benchmark(args):
+    overhead = args.packet_overhead
+    frames_per_hour = 3600.0 / args.frame_interval
+
+    entity_bytes = 0
+    for domain, object_id, payload in PER_FRAME_ENTITIES:
+        topic = f"{args.prefix}/{domain}/{object_id}/state"
+        entity_bytes += mqtt_publish_size(topic, len(payload)) + overhead
+    entity_packets = len(PER_FRAME_ENTITIES) * frames_per_hour
+    entity_hour = entity_bytes * frames_per_hour
+
+    topic = f"{args.prefix}/vevor_heater/heater/telemetry"
+    packet = mqtt_publish_size(topic, PAYLOAD_SIZE) + overhead
+    telemetry_packets = 3600.0 / args.interval + args.state_changes
+    telemetry_hour = packet * telemetry_packets
+
+    print(f"Heater active, status frame every {args.frame_interval:g} s, {overhead} bytes per packet overhead")
+    print(f"{'mode':>12} {'packets/h':>10} {'bytes/h':>10} {'MB/month':>9}")
+    for name, packets, total in (("per-entity", entity_packets, entity_hour),
+                                 ("telemetry", telemetry_packets, telemetry_hour)):
+        print(f"{name:>12} {packets:>10.0f} {total:>10.0f} {total * 24 * 30 / 1e6:>9.2f}")
+    print(f"\nTelemetry payload {PAYLOAD_SIZE} bytes, {packet} bytes per publish; "
+          f"{entity_hour / telemetry_hour:.0f}x less data than per-entity publishing")
+    return 0
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    sub = parser.add_subparsers(dest="command", required=True)
+
+    dec = sub.add_parser("decode", help="Decode payloads from stdin (hex) or a raw file")
+    dec.add_argument("--raw", help="File holding one raw payload")
+    dec.set_defaults(func=command_decode)
+
+    bench = sub.add_parser("benchmark", help="Bytes on air per hour, telemetry against per-entity publishing")
+    bench.add_argument("--prefix", default="camper", help="MQTT topic prefix (node name)")
+    bench.add_argument("--interval", type=float, default=60.0, help="Telemetry batch interval in s")
+    bench.add_argument("--state-changes", type=int, default=6, help="Extra publishes per hour for state changes")
+    bench.add_argument("--frame-interval", type=float, default=1.0, help="Status frame interval in s")
+    bench.add_argument("--packet-overhead", type=int, default=52,
+                       help="TCP/IP bytes per packet (52 = IPv4 + TCP with timestamps, add ~29 for TLS)")
+    bench.set_defaults(func=command_benchmark)
+
+    args = parser.parse_args()
+    return args.func(args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())